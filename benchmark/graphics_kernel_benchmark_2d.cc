@@ -0,0 +1,168 @@
+// This is free and unencumbered software released into the public domain.
+// For more information, please refer to <http://unlicense.org/>
+
+// This is a standalone program that measures the speedup of the vectorized
+// GraphicsKernel2d segment clipping over its scalar path.
+//
+// Random segments are generated across a data region, and clipped to views
+// that show all, a quarter, and a hundredth of the region. Each path is run
+// several times and the fastest time is reported, along with the number of
+// visible segments. The program fails if the two paths produce different
+// points.
+//
+// usage: graphics_kernel_benchmark_2d [num_segments] [num_repeats]
+//
+// The program must be compiled with optimizations, and linked with the
+// AppCommon graphics sources and wxWidgets. The vectorized path is only used
+// on targets with SSE2.
+
+#include <algorithm>
+#include <chrono>  // NOLINT
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "wx/wx.h"
+
+#include "appcommon/graphics/graphics_kernel_2d.h"
+#include "appcommon/graphics/plot_axis.h"
+
+namespace {
+
+/// The height of the view, in pixels.
+const int kHeight = 1080;
+
+/// The width and height of the synthetic data region, in data units.
+const float kSizeData = 10000;
+
+/// The maximum length of a segment along each axis, in data units.
+const float kSizeSegment = 50;
+
+/// The width of the view, in pixels.
+const int kWidth = 1920;
+
+/// \par OVERVIEW
+///
+/// This struct is a view that is benchmarked.
+struct View {
+  /// \var name
+  ///   The name that is reported.
+  std::string name;
+
+  /// \var range
+  ///   The horizontal and vertical range of the axes, in data units.
+  float range;
+};
+
+/// \brief Gets the time since a start time.
+/// \param[in] time_start
+///   The start time.
+/// \return The elapsed time, in milliseconds.
+double Elapsed(const std::chrono::steady_clock::time_point& time_start) {
+  const std::chrono::duration<double, std::milli> duration =
+      std::chrono::steady_clock::now() - time_start;
+  return duration.count();
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  // parses the optional arguments
+  std::size_t num_segments = 1000000;
+  int num_repeats = 10;
+  if (2 <= argc) {
+    num_segments = std::strtoull(argv[1], nullptr, 10);
+  }
+  if (3 <= argc) {
+    num_repeats = std::max(1, std::atoi(argv[2]));
+  }
+
+  // generates the segments
+  std::mt19937 generator(1);
+  std::uniform_real_distribution<float> distribution_point(0, kSizeData);
+  std::uniform_real_distribution<float> distribution_delta(-kSizeSegment,
+                                                           kSizeSegment);
+
+  std::vector<float> x0(num_segments);
+  std::vector<float> y0(num_segments);
+  std::vector<float> x1(num_segments);
+  std::vector<float> y1(num_segments);
+  for (std::size_t i = 0; i < num_segments; i++) {
+    x0[i] = distribution_point(generator);
+    y0[i] = distribution_point(generator);
+    x1[i] = x0[i] + distribution_delta(generator);
+    y1[i] = y0[i] + distribution_delta(generator);
+  }
+
+  std::printf("segments: %zu, vectorized: %s\n", num_segments,
+              (GraphicsKernel2d::IsVectorized() == true) ? "yes" : "no");
+  std::printf("%-10s %10s %12s %12s %8s\n", "view", "visible", "scalar (ms)",
+              "kernel (ms)", "speedup");
+
+  const View kViews[] = {
+    {"full", kSizeData},
+    {"quarter", kSizeData / 2},
+    {"hundredth", kSizeData / 10},
+  };
+
+  const wxRect rc(0, 0, kWidth, kHeight);
+  std::vector<wxPoint> points_scalar;
+  std::vector<wxPoint> points_kernel;
+  points_scalar.reserve(num_segments * 2);
+  points_kernel.reserve(num_segments * 2);
+
+  for (std::size_t index = 0; index < sizeof(kViews) / sizeof(View);
+       index++) {
+    const View& view = kViews[index];
+
+    // centers the axes on the data region
+    PlotAxis axis_horizontal(PlotAxis::OrientationType::kHorizontal);
+    axis_horizontal.set_position_center(kSizeData / 2);
+    axis_horizontal.set_range(view.range);
+
+    PlotAxis axis_vertical(PlotAxis::OrientationType::kVertical);
+    axis_vertical.set_position_center(kSizeData / 2);
+    axis_vertical.set_range(view.range);
+
+    const GraphicsKernel2d kernel(axis_horizontal, axis_vertical, rc);
+
+    // measures each path, keeping the fastest repeat
+    double duration_scalar = 0;
+    double duration_kernel = 0;
+    for (int i = 0; i < num_repeats; i++) {
+      points_scalar.clear();
+      std::chrono::steady_clock::time_point time_start =
+          std::chrono::steady_clock::now();
+      kernel.ClipSegmentsScalar(x0.data(), y0.data(), x1.data(), y1.data(),
+                                0, num_segments, points_scalar);
+      double duration = Elapsed(time_start);
+      if ((i == 0) || (duration < duration_scalar)) {
+        duration_scalar = duration;
+      }
+
+      points_kernel.clear();
+      time_start = std::chrono::steady_clock::now();
+      kernel.ClipSegments(x0.data(), y0.data(), x1.data(), y1.data(),
+                          num_segments, points_kernel);
+      duration = Elapsed(time_start);
+      if ((i == 0) || (duration < duration_kernel)) {
+        duration_kernel = duration;
+      }
+    }
+
+    // checks that both paths produce the same points
+    if (points_scalar != points_kernel) {
+      std::fprintf(stderr, "The scalar and kernel points differ for the %s "
+                   "view.\n", view.name.c_str());
+      return EXIT_FAILURE;
+    }
+
+    std::printf("%-10s %10zu %12.3f %12.3f %7.2fx\n", view.name.c_str(),
+                points_kernel.size() / 2, duration_scalar, duration_kernel,
+                duration_scalar / std::max(duration_kernel, 1e-6));
+  }
+
+  return EXIT_SUCCESS;
+}
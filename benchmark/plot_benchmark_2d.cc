@@ -0,0 +1,321 @@
+// This is free and unencumbered software released into the public domain.
+// For more information, please refer to <http://unlicense.org/>
+
+// This is a standalone program that measures the plot rendering performance.
+//
+// Synthetic line, point, circle, and text datasets are generated at sizes from
+// 1e3 up to the maximum size (1e7 by default), and rendered headlessly into a
+// wxMemoryDC at several zoom and pan states. Each view is rendered with the
+// vertex cache off and then on, so the warm times show both the uncached draw
+// and the cached pan. The time, drawn elements, and culled elements are
+// reported for each renderer, using the statistics that Renderer2d keeps for
+// the last render.
+//
+// usage: plot_benchmark_2d [size_max] [num_repeats]
+//
+// The program must be compiled and linked with the AppCommon graphics sources,
+// OTLS-Models, and wxWidgets. On platforms where wxWidgets needs a display
+// server for device contexts (e.g. GTK), a display must be available.
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+
+#include "wx/init.h"
+#include "wx/wx.h"
+
+#include "appcommon/graphics/circle_data_set_2d.h"
+#include "appcommon/graphics/circle_renderer_2d.h"
+#include "appcommon/graphics/line_data_set_2d.h"
+#include "appcommon/graphics/line_renderer_2d.h"
+#include "appcommon/graphics/plot_2d.h"
+#include "appcommon/graphics/point_data_set_2d.h"
+#include "appcommon/graphics/point_renderer_2d.h"
+#include "appcommon/graphics/text_data_set_2d.h"
+#include "appcommon/graphics/text_renderer_2d.h"
+
+namespace {
+
+/// The height of the rendered image, in pixels.
+const int kHeight = 768;
+
+/// The minimum dataset size.
+const std::size_t kSizeMin = 1000;
+
+/// The width of the rendered image, in pixels.
+const int kWidth = 1024;
+
+/// The width and height of the synthetic data region, in data units.
+const float kSizeData = 10000;
+
+/// \par OVERVIEW
+///
+/// This struct is a plot view that is benchmarked.
+struct View {
+  /// \var name
+  ///   The name that is reported.
+  std::string name;
+
+  /// \var shift
+  ///   The horizontal shift (in pixels) that is applied after zooming.
+  int shift;
+
+  /// \var zoom
+  ///   The zoom factor that is applied to the fitted plot.
+  float zoom;
+};
+
+/// \brief Generates a line dataset.
+/// \param[in] size
+///   The number of lines.
+/// \param[in,out] generator
+///   The random number generator.
+/// \return The dataset, which forms a noisy profile along the x axis.
+LineDataSet2d* GenerateLines(const std::size_t& size,
+                             std::mt19937& generator) {
+  std::uniform_real_distribution<float> distribution(-1, 1);
+
+  LineDataSet2d* dataset = new LineDataSet2d();
+  dataset->Reserve(size);
+
+  const float step = kSizeData / size;
+  float y = kSizeData / 2;
+  for (std::size_t i = 0; i < size; i++) {
+    Line2d line;
+    line.p0.x = i * step;
+    line.p0.y = y;
+
+    y += distribution(generator) * kSizeData / 1000;
+    line.p1.x = (i + 1) * step;
+    line.p1.y = y;
+
+    dataset->Add(line);
+  }
+
+  return dataset;
+}
+
+/// \brief Generates a point dataset.
+/// \param[in] size
+///   The number of points.
+/// \param[in,out] generator
+///   The random number generator.
+/// \return The dataset, which is uniformly distributed.
+PointDataSet2d* GeneratePoints(const std::size_t& size,
+                               std::mt19937& generator) {
+  std::uniform_real_distribution<float> distribution(0, kSizeData);
+
+  PointDataSet2d* dataset = new PointDataSet2d();
+  for (std::size_t i = 0; i < size; i++) {
+    Point2d<float> point;
+    point.x = distribution(generator);
+    point.y = distribution(generator);
+
+    dataset->Add(point);
+  }
+
+  return dataset;
+}
+
+/// \brief Generates a circle dataset.
+/// \param[in] size
+///   The number of circles.
+/// \param[in,out] generator
+///   The random number generator.
+/// \return The dataset, which is uniformly distributed.
+CircleDataSet2d* GenerateCircles(const std::size_t& size,
+                                 std::mt19937& generator) {
+  std::uniform_real_distribution<float> distribution(0, kSizeData);
+  std::uniform_int_distribution<unsigned int> distribution_radius(2, 6);
+
+  CircleDataSet2d* dataset = new CircleDataSet2d();
+  for (std::size_t i = 0; i < size; i++) {
+    Circle2d circle;
+    circle.center.x = distribution(generator);
+    circle.center.y = distribution(generator);
+    circle.radius = distribution_radius(generator);
+
+    dataset->Add(circle);
+  }
+
+  return dataset;
+}
+
+/// \brief Generates a text dataset.
+/// \param[in] size
+///   The number of text labels.
+/// \param[in,out] generator
+///   The random number generator.
+/// \return The dataset, which is uniformly distributed.
+TextDataSet2d* GenerateText(const std::size_t& size,
+                            std::mt19937& generator) {
+  std::uniform_real_distribution<float> distribution(0, kSizeData);
+
+  TextDataSet2d* dataset = new TextDataSet2d();
+  for (std::size_t i = 0; i < size; i++) {
+    Text2d text;
+    text.angle = (i % 4 == 0) ? 90 : 0;
+    text.message = "Label " + std::to_string(i % 1000);
+    text.offset.x = 0;
+    text.offset.y = 0;
+    text.point.x = distribution(generator);
+    text.point.y = distribution(generator);
+    text.position = Text2d::BoundaryPosition::kCenterLower;
+
+    dataset->Add(text);
+  }
+
+  return dataset;
+}
+
+/// \brief Benchmarks a renderer at all of the views, without and with the
+///   vertex cache.
+/// \param[in] name
+///   The dataset name that is reported.
+/// \param[in] renderer
+///   The renderer, which must have a dataset. The benchmark plot takes
+///   ownership of the pointer, and deletes it before this returns.
+/// \param[in] num_repeats
+///   The number of renders for each view. The fastest is reported.
+void Benchmark(const std::string& name, Renderer2d* renderer,
+               const int& num_repeats) {
+  const View kViews[] = {
+    {"fitted", 0, 1},
+    {"zoom 10x", 0, 10},
+    {"zoom 10x pan", kWidth / 4, 10},
+    {"zoom 100x", 0, 100},
+    {"zoom 100x pan", kWidth / 4, 100},
+  };
+
+  // the statistics are read through the renderer pointer, which stays valid
+  // until the plot is destroyed
+  Plot2d plot;
+  plot.AddRenderer(renderer);
+
+  wxBitmap bitmap(kWidth, kHeight);
+  wxMemoryDC dc(bitmap);
+  const wxRect rc(0, 0, kWidth, kHeight);
+  const wxPoint point_center(kWidth / 2, kHeight / 2);
+
+  const bool kIsCached[] = {false, true};
+  for (std::size_t index_cached = 0;
+       index_cached < sizeof(kIsCached) / sizeof(bool); index_cached++) {
+    const bool& is_cached = kIsCached[index_cached];
+    renderer->set_is_cached(is_cached);
+
+    for (std::size_t index = 0; index < sizeof(kViews) / sizeof(View);
+         index++) {
+      const View& view = kViews[index];
+
+      // fits the plot and then applies the zoom
+      plot.set_is_fitted(true);
+      plot.FitToRect(rc);
+      if (view.zoom != 1) {
+        plot.Zoom(view.zoom, point_center);
+      }
+
+      // renders once to build any lazy indexes and caches, and then measures
+      // the repeated renders, which shift between each one if panning
+      plot.Render(dc, rc);
+      const double duration_cold = renderer->statistics().duration;
+
+      double duration_min = duration_cold;
+      for (int i = 0; i < num_repeats; i++) {
+        if (view.shift != 0) {
+          plot.Shift(view.shift / num_repeats, 0);
+        }
+
+        plot.Render(dc, rc);
+        duration_min = std::min(duration_min,
+                                renderer->statistics().duration);
+      }
+
+      const Renderer2dStatistics& statistics = renderer->statistics();
+      std::printf("%-8s %10zu  %-14s %-6s %10.3f %10.3f %10zu %10zu\n",
+                  name.c_str(), statistics.count_total, view.name.c_str(),
+                  (is_cached == true) ? "on" : "off", duration_cold,
+                  duration_min, statistics.count_drawn,
+                  statistics.count_total - statistics.count_drawn);
+    }
+  }
+
+  dc.SelectObject(wxNullBitmap);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  wxInitializer initializer;
+  if (initializer.IsOk() == false) {
+    std::fprintf(stderr, "Failed to initialize wxWidgets.\n");
+    return EXIT_FAILURE;
+  }
+
+  // parses the optional arguments
+  std::size_t size_max = 10000000;
+  int num_repeats = 5;
+  if (2 <= argc) {
+    size_max = std::strtoull(argv[1], nullptr, 10);
+  }
+  if (3 <= argc) {
+    num_repeats = std::max(1, std::atoi(argv[2]));
+  }
+
+  std::printf("%-8s %10s  %-14s %-6s %10s %10s %10s %10s\n", "dataset",
+              "size", "view", "cache", "cold (ms)", "warm (ms)", "drawn",
+              "culled");
+
+  std::mt19937 generator(1);
+  const wxPen pen(*wxBLACK, 1);
+  const wxBrush brush(*wxBLUE);
+  const wxColour color(*wxBLACK);
+
+  // benchmarks each dataset type at each size
+  // the spatial index is enabled so off screen elements are culled
+  for (std::size_t size = kSizeMin; size <= size_max; size *= 10) {
+    {
+      LineDataSet2d* dataset = GenerateLines(size, generator);
+      dataset->set_is_indexed(true);
+      LineRenderer2d* renderer = new LineRenderer2d();
+      renderer->set_dataset(dataset);
+      renderer->set_pen(&pen);
+      Benchmark("line", renderer, num_repeats);
+      delete dataset;
+    }
+
+    {
+      PointDataSet2d* dataset = GeneratePoints(size, generator);
+      dataset->set_is_indexed(true);
+      PointRenderer2d* renderer = new PointRenderer2d();
+      renderer->set_dataset(dataset);
+      renderer->set_pen(&pen);
+      Benchmark("point", renderer, num_repeats);
+      delete dataset;
+    }
+
+    {
+      CircleDataSet2d* dataset = GenerateCircles(size, generator);
+      dataset->set_is_indexed(true);
+      CircleRenderer2d* renderer = new CircleRenderer2d();
+      renderer->set_dataset(dataset);
+      renderer->set_brush(&brush);
+      renderer->set_pen(&pen);
+      Benchmark("circle", renderer, num_repeats);
+      delete dataset;
+    }
+
+    {
+      TextDataSet2d* dataset = GenerateText(size, generator);
+      dataset->set_is_indexed(true);
+      TextRenderer2d* renderer = new TextRenderer2d();
+      renderer->set_dataset(dataset);
+      renderer->set_color(&color);
+      Benchmark("text", renderer, num_repeats);
+      delete dataset;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
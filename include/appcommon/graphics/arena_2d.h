@@ -0,0 +1,122 @@
+// This is free and unencumbered software released into the public domain.
+// For more information, please refer to <http://unlicense.org/>
+
+#ifndef APPCOMMON_GRAPHICS_ARENA_2D_H_
+#define APPCOMMON_GRAPHICS_ARENA_2D_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <new>
+#include <vector>
+
+/// \par OVERVIEW
+///
+/// This class template is an arena that constructs elements in chunked slabs.
+///
+/// \par SLABS
+///
+/// Each slab is a single allocation with room for a fixed number of elements.
+/// Elements are constructed in order, and a new slab is only allocated when
+/// the last one is full, so adding many elements costs one heap allocation per
+/// slab instead of one per element. Elements never move once constructed, so
+/// pointers to them stay valid until the arena is cleared.
+///
+/// \par CLEARING
+///
+/// Elements cannot be freed individually. Clear() destroys all of the
+/// elements and releases every slab at once.
+template <class T>
+class Arena2d {
+ public:
+  /// \brief Constructor.
+  /// \param[in] size_slab
+  ///   The number of elements in each slab.
+  explicit Arena2d(const std::size_t& size_slab = 4096);
+
+  /// \brief Destructor.
+  ~Arena2d();
+
+  /// \brief Copy constructor. The arena owns its slabs, so it is not copied.
+  Arena2d(const Arena2d&) = delete;
+
+  /// \brief Assignment operator. The arena owns its slabs, so it is not
+  ///   assigned.
+  Arena2d& operator=(const Arena2d&) = delete;
+
+  /// \brief Destroys all of the elements and releases the slabs.
+  void Clear();
+
+  /// \brief Constructs an element in the arena.
+  /// \param[in] value
+  ///   The value that is copied into the element.
+  /// \return The element, which is valid until the arena is cleared.
+  T* Emplace(const T& value);
+
+  /// \brief Gets the number of elements.
+  /// \return The number of elements.
+  std::size_t Size() const;
+
+ private:
+  /// \var size_
+  ///   The number of constructed elements.
+  std::size_t size_;
+
+  /// \var size_slab_
+  ///   The number of elements in each slab.
+  std::size_t size_slab_;
+
+  /// \var slabs_
+  ///   The slab storage, in allocation order. Only the last slab can be
+  ///   partially filled.
+  std::vector<T*> slabs_;
+};
+
+template <class T>
+Arena2d<T>::Arena2d(const std::size_t& size_slab) {
+  size_ = 0;
+  size_slab_ = std::max(size_slab, static_cast<std::size_t>(1));
+}
+
+template <class T>
+Arena2d<T>::~Arena2d() {
+  Clear();
+}
+
+template <class T>
+void Arena2d<T>::Clear() {
+  for (std::size_t index = 0; index < slabs_.size(); index++) {
+    T* slab = slabs_[index];
+
+    // destroys the constructed elements in the slab
+    const std::size_t count = std::min(size_slab_,
+                                       size_ - index * size_slab_);
+    for (std::size_t i = 0; i < count; i++) {
+      slab[i].~T();
+    }
+
+    ::operator delete(slab);
+  }
+
+  slabs_.clear();
+  size_ = 0;
+}
+
+template <class T>
+T* Arena2d<T>::Emplace(const T& value) {
+  // allocates a new slab if the last one is full
+  if (size_ == slabs_.size() * size_slab_) {
+    slabs_.push_back(static_cast<T*>(::operator new(sizeof(T) * size_slab_)));
+  }
+
+  T* element = new (slabs_.back() + size_ % size_slab_) T(value);
+  size_++;
+
+  return element;
+}
+
+template <class T>
+std::size_t Arena2d<T>::Size() const {
+  return size_;
+}
+
+#endif  // APPCOMMON_GRAPHICS_ARENA_2D_H_
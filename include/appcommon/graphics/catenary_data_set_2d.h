@@ -0,0 +1,167 @@
+// This is free and unencumbered software released into the public domain.
+// For more information, please refer to <http://unlicense.org/>
+
+#ifndef APPCOMMON_GRAPHICS_CATENARY_DATA_SET_2D_H_
+#define APPCOMMON_GRAPHICS_CATENARY_DATA_SET_2D_H_
+
+#include <cstddef>
+#include <vector>
+
+#include "models/base/point.h"
+
+#include "appcommon/graphics/arena_2d.h"
+#include "appcommon/graphics/data_set_2d.h"
+#include "appcommon/graphics/spatial_index_2d.h"
+
+/// \par OVERVIEW
+///
+/// This struct represents a 2D catenary curve between two horizontal
+/// positions.
+///
+/// The curve is defined as:
+///   y = y_lowest + constant * (cosh((x - x_lowest) / constant) - 1)
+///
+/// The name avoids the Catenary2d class of the models library, which is used
+/// alongside this struct.
+struct CatenaryCurve2d {
+  /// \var constant
+  ///   The catenary constant, which is the horizontal tension divided by the
+  ///   unit weight. This is in data units and must be positive.
+  float constant;
+
+  /// \var point_lowest
+  ///   The lowest point of the catenary curve. This can be outside of the
+  ///   start and end positions for inclined spans.
+  Point2d<float> point_lowest;
+
+  /// \var x_end
+  ///   The horizontal position where the curve ends.
+  float x_end;
+
+  /// \var x_start
+  ///   The horizontal position where the curve starts.
+  float x_start;
+};
+
+/// \par OVERVIEW
+///
+/// This class represents a set of 2D catenary curves.
+///
+/// \par ANALYTIC STORAGE
+///
+/// The curves are stored as their catenary parameters instead of line
+/// segments, so each curve only takes a few values regardless of its length.
+/// The bounds of each curve are solved analytically, and the curve is
+/// tessellated by the renderer to match the current view.
+///
+/// The parameters are constructed in a dataset-owned arena of fixed size
+/// slabs, which Clear() releases at once.
+class CatenaryDataSet2d : public DataSet2d {
+ public:
+  /// \brief Constructor.
+  CatenaryDataSet2d();
+
+  /// \brief Destructor.
+  virtual ~CatenaryDataSet2d();
+
+  /// \brief Adds a catenary to the dataset.
+  /// \param[in] catenary
+  ///   The catenary.
+  /// \return If the catenary was added. A catenary without a positive constant
+  ///   is not added.
+  /// This class will take ownership of the pointer. The catenary is copied into
+  /// the arena and the pointer is deleted immediately, even if the catenary is
+  /// not added. The caller must not use the pointer after this returns.
+  bool Add(const CatenaryCurve2d* catenary);
+
+  /// \brief Adds a catenary to the dataset.
+  /// \param[in] catenary
+  ///   The catenary.
+  /// \return If the catenary was added. A catenary without a positive constant
+  ///   is not added, as its curve and bounds cannot be solved.
+  /// The catenary is constructed in the arena, so no separate allocation is
+  /// needed.
+  bool Add(const CatenaryCurve2d& catenary);
+
+  /// \brief Gets the bounds of a catenary.
+  /// \param[in] catenary
+  ///   The catenary.
+  /// \return The bounding box between the start and end positions.
+  static BoundingBox2d Bounds(const CatenaryCurve2d& catenary);
+
+  /// \brief Clears all of the stored catenaries.
+  void Clear();
+
+  /// \brief Gets the maximum x value.
+  /// \return The maximum x value.
+  float MaxX() const override;
+
+  /// \brief Gets the maximum y value.
+  /// \return The maximum y value.
+  float MaxY() const override;
+
+  /// \brief Gets the minimum x value.
+  /// \return The minimum x value.
+  float MinX() const override;
+
+  /// \brief Gets the minimum y value.
+  /// \return The minimum y value.
+  float MinY() const override;
+
+  /// \brief Gets the element nearest to a point.
+  /// \param[in] point
+  ///   The point, in data units.
+  /// \param[in] scale_x
+  ///   The factor that scales x data units to graphics units.
+  /// \param[in] scale_y
+  ///   The factor that scales y data units to graphics units.
+  /// \param[in] radius
+  ///   The maximum distance, in graphics units.
+  /// \param[out] index
+  ///   The catenary index.
+  /// \param[out] distance
+  ///   The distance to the catenary curve, in graphics units.
+  /// \return If a catenary was found within the radius.
+  bool Nearest(const Point2d<float>& point, const float& scale_x,
+               const float& scale_y, const float& radius,
+               unsigned int& index, float& distance) const override;
+
+  /// \brief Gets the curvature of a catenary.
+  /// \param[in] catenary
+  ///   The catenary.
+  /// \param[in] x
+  ///   The horizontal position.
+  /// \return The second derivative of the curve at the position.
+  static double Curvature(const CatenaryCurve2d& catenary, const double& x);
+
+  /// \brief Gets the vertical position of a catenary.
+  /// \param[in] catenary
+  ///   The catenary.
+  /// \param[in] x
+  ///   The horizontal position.
+  /// \return The vertical position of the curve.
+  static double PositionY(const CatenaryCurve2d& catenary, const double& x);
+
+  /// \brief Gets the number of catenaries.
+  /// \return The number of catenaries.
+  std::size_t Size() const;
+
+  /// \brief Gets the elements.
+  /// \return The elements, in the order they were added.
+  const std::vector<const CatenaryCurve2d*>* elements() const;
+
+ private:
+  /// \brief Updates the spatial index.
+  /// \return If the index was built.
+  bool UpdateIndex() const override;
+
+  /// \var arena_
+  ///   The arena that owns the catenary storage.
+  Arena2d<CatenaryCurve2d> arena_;
+
+  /// \var elements_
+  ///   The catenary data.
+  std::vector<const CatenaryCurve2d*> elements_;
+};
+
+#endif  // APPCOMMON_GRAPHICS_CATENARY_DATA_SET_2D_H_
@@ -0,0 +1,137 @@
+// This is free and unencumbered software released into the public domain.
+// For more information, please refer to <http://unlicense.org/>
+
+#ifndef APPCOMMON_GRAPHICS_CATENARY_RENDERER_2D_H_
+#define APPCOMMON_GRAPHICS_CATENARY_RENDERER_2D_H_
+
+#include <vector>
+
+#include "wx/wx.h"
+
+#include "appcommon/graphics/catenary_data_set_2d.h"
+#include "appcommon/graphics/renderer_2d.h"
+
+/// \par OVERVIEW
+///
+/// This class renders a catenary dataset onto a plot.
+///
+/// \par TESSELLATION
+///
+/// The visible portion of each catenary is tessellated into line segments
+/// every time it is drawn. The step between vertices is solved from the
+/// curvature so that the chord deviates from the curve by no more than the
+/// tolerance (in pixels), which keeps the curve smooth at any zoom level while
+/// limiting the number of segments to roughly what the screen can resolve.
+///
+/// The tessellation depends on the current view, so the vertex cache is not
+/// used.
+class CatenaryRenderer2d : public Renderer2dT<CatenaryDataSet2d> {
+ public:
+  /// \brief Constructor.
+  CatenaryRenderer2d();
+
+  /// \brief Clones the renderer.
+  /// \return A new renderer that draws the same dataset with copies of the
+  ///   same styles. The caller takes ownership of the pointer.
+  Renderer2d* Clone() const override;
+
+  /// \brief Draws the data onto the device context.
+  /// \param[in] dc
+  ///   The device context.
+  /// \param[in] rc
+  ///   The dc region to draw onto.
+  /// \param[in] axis_horizontal
+  ///   The horizontal plot axis.
+  /// \param[in] axis_vertical
+  ///   The vertical plot axis.
+  void Draw(wxDC& dc, wxRect rc, const PlotAxis& axis_horizontal,
+            const PlotAxis& axis_vertical) const override;
+
+  /// \brief Writes the data to a vector file.
+  /// \param[in] dc
+  ///   The device context that supplies the background colour.
+  /// \param[in] writer
+  ///   The vector file writer.
+  /// \param[in] rc
+  ///   The region to write to.
+  /// \param[in] axis_horizontal
+  ///   The horizontal plot axis.
+  /// \param[in] axis_vertical
+  ///   The vertical plot axis.
+  void Export(wxDC& dc, SvgWriter2d& writer, wxRect rc,
+              const PlotAxis& axis_horizontal,
+              const PlotAxis& axis_vertical) const override;
+
+  /// \brief Gets the pen.
+  /// \return The pen.
+  const wxPen* pen() const;
+
+  /// \brief Sets the pen.
+  /// \param[in] pen
+  ///   The pen.
+  void set_pen(const wxPen* pen);
+
+  /// \brief Sets the tolerance.
+  /// \param[in] tolerance
+  ///   The maximum distance (in pixels) between the curve and a segment.
+  void set_tolerance(const float& tolerance);
+
+  /// \brief Gets the tolerance.
+  /// \return The maximum distance (in pixels) between the curve and a segment.
+  float tolerance() const;
+
+ private:
+  /// \brief Tessellates a catenary into line segments.
+  /// \param[in] catenary
+  ///   The catenary.
+  /// \param[in] x_min
+  ///   The minimum x value to tessellate.
+  /// \param[in] x_max
+  ///   The maximum x value to tessellate.
+  /// \param[in] scale_x
+  ///   The factor that scales x data units to graphics units.
+  /// \param[in] scale_y
+  ///   The factor that scales y data units to graphics units.
+  /// \param[in,out] x0
+  ///   The segment start point x values.
+  /// \param[in,out] y0
+  ///   The segment start point y values.
+  /// \param[in,out] x1
+  ///   The segment end point x values.
+  /// \param[in,out] y1
+  ///   The segment end point y values.
+  void Tessellate(const CatenaryCurve2d& catenary,
+                  const double& x_min, const double& x_max,
+                  const double& scale_x, const double& scale_y,
+                  std::vector<float>& x0, std::vector<float>& y0,
+                  std::vector<float>& x1, std::vector<float>& y1) const;
+
+  /// \brief Tessellates the visible catenaries and transforms them to graphics
+  ///   coordinates.
+  /// \param[in] rc
+  ///   The dc region to draw onto.
+  /// \param[in] axis_horizontal
+  ///   The horizontal plot axis.
+  /// \param[in] axis_vertical
+  ///   The vertical plot axis.
+  /// \param[out] points
+  ///   The visible segments, stored as consecutive start and end points.
+  ///   These are wxPoint for drawing, or wxRealPoint for exporting without
+  ///   rounding.
+  /// \return The number of catenaries that were tessellated.
+  template <typename T>
+  std::size_t TransformCatenaries(const wxRect& rc,
+                                  const PlotAxis& axis_horizontal,
+                                  const PlotAxis& axis_vertical,
+                                  std::vector<T>& points) const;
+
+  /// \var pen_
+  ///   The pen.
+  const wxPen* pen_;
+
+  /// \var tolerance_
+  ///   The maximum distance (in pixels) between the curve and a segment.
+  float tolerance_;
+};
+
+#endif  // APPCOMMON_GRAPHICS_CATENARY_RENDERER_2D_H_
@@ -4,10 +4,13 @@
 #ifndef APPCOMMON_GRAPHICS_CIRCLE_DATA_SET_2D_H_
 #define APPCOMMON_GRAPHICS_CIRCLE_DATA_SET_2D_H_
 
+#include <cstddef>
 #include <list>
+#include <vector>
 
 #include "models/base/point.h"
 
+#include "appcommon/graphics/arena_2d.h"
 #include "appcommon/graphics/data_set_2d.h"
 
 /// \par OVERVIEW
@@ -28,6 +31,19 @@ struct Circle2d {
 /// \par OVERVIEW
 ///
 /// This class represents a set of 2D lines.
+///
+/// \par STORAGE
+///
+/// The circles are kept in a dataset-owned arena of fixed size slabs instead
+/// of individual heap allocations. Clear() releases all of the slabs at once.
+/// Circles that are added by pointer are kept as is, outside of the arena.
+///
+/// \par SPATIAL INDEX
+///
+/// The circle radius is in graphics units, so the data extent of a circle
+/// depends on the plot scale. The index only contains the circle centers, and
+/// queries are expanded by the largest radius at the current scale, so
+/// circles that overlap the edge of a region are still found.
 class CircleDataSet2d : public DataSet2d {
  public:
   /// \brief Constructor.
@@ -39,12 +55,39 @@ class CircleDataSet2d : public DataSet2d {
   /// \brief Adds a circle to the dataset.
   /// \param[in] circle
   ///   The circle.
-  /// This class will take ownership of the pointer.
+  /// This class will take ownership of the pointer, which stays valid until
+  /// the dataset is cleared.
   void Add(const Circle2d* circle);
 
+  /// \brief Adds a circle to the dataset.
+  /// \param[in] circle
+  ///   The circle.
+  /// The circle is constructed in the arena, so no separate allocation is
+  /// needed.
+  void Add(const Circle2d& circle);
+
   /// \brief Clears all of the stored circles.
   void Clear();
 
+  /// \brief Gets the indexes of the circles that may intersect the plot axes.
+  /// \param[in] axis_horizontal
+  ///   The horizontal plot axis.
+  /// \param[in] axis_vertical
+  ///   The vertical plot axis.
+  /// \param[in] scale_x
+  ///   The factor that scales x data units to graphics units.
+  /// \param[in] scale_y
+  ///   The factor that scales y data units to graphics units.
+  /// \param[out] indexes
+  ///   The circle indexes, sorted in ascending order.
+  /// \return If the dataset is indexed. If not, the indexes are not modified
+  ///   and every circle needs to be checked.
+  using DataSet2d::IndexesVisible;
+  bool IndexesVisible(const PlotAxis& axis_horizontal,
+                      const PlotAxis& axis_vertical, const float& scale_x,
+                      const float& scale_y,
+                      std::vector<unsigned int>& indexes) const;
+
   /// \brief Gets the maximum x value.
   /// \return The maximum x value.
   float MaxX() const override;
@@ -61,21 +104,77 @@ class CircleDataSet2d : public DataSet2d {
   /// \return The minimum y value.
   float MinY() const override;
 
+  /// \brief Gets the element nearest to a point.
+  /// \param[in] point
+  ///   The point, in data units.
+  /// \param[in] scale_x
+  ///   The factor that scales x data units to graphics units.
+  /// \param[in] scale_y
+  ///   The factor that scales y data units to graphics units.
+  /// \param[in] radius
+  ///   The maximum distance, in graphics units.
+  /// \param[out] index
+  ///   The circle index.
+  /// \param[out] distance
+  ///   The distance to the circle edge, in graphics units.
+  /// \return If a circle was found within the radius.
+  bool Nearest(const Point2d<float>& point, const float& scale_x,
+               const float& scale_y, const float& radius,
+               unsigned int& index, float& distance) const override;
+
+  /// \brief Gets the largest radius.
+  /// \return The largest radius, in graphics units.
+  unsigned int RadiusMax() const;
+
+  /// \brief Gets the number of circles.
+  /// \return The number of circles.
+  std::size_t Size() const;
+
   /// \brief Gets the data.
   /// \return The data.
+  /// This list is generated from the element storage when it is out of date.
+  /// Use elements() instead when possible.
   const std::list<const Circle2d*>* data() const;
 
+  /// \brief Gets the elements.
+  /// \return The elements, in the order they were added.
+  const std::vector<const Circle2d*>* elements() const;
+
  private:
-  /// \brief Updates the cached values.
-  void Update() const;
+  /// \brief Adds an element that is already constructed.
+  /// \param[in] circle
+  ///   The circle, which is owned by the arena or by the pointer list.
+  void AddElement(const Circle2d* circle);
+
+  /// \brief Updates the spatial index.
+  /// \return If the index was built.
+  bool UpdateIndex() const override;
+
+  /// \var arena_
+  ///   The arena that owns the circle storage.
+  Arena2d<Circle2d> arena_;
 
   /// \var data_
+  ///   The element pointers that are generated for data().
+  mutable std::list<const Circle2d*> data_;
+
+  /// \var elements_
   ///   The line data.
-  std::list<const Circle2d*> data_;
+  std::vector<const Circle2d*> elements_;
+
+  /// \var is_updated_data_
+  ///   An indicator that tells if the element pointers generated for data()
+  ///   are updated.
+  mutable bool is_updated_data_;
+
+  /// \var pointers_
+  ///   The elements that were added by pointer, which are deleted when the
+  ///   dataset is cleared.
+  std::vector<const Circle2d*> pointers_;
 
-  /// \var is_updated_
-  ///   An indicator that tells if the cached values have been updated.
-  mutable bool is_updated_;
+  /// \var radius_max_
+  ///   The largest radius, in graphics units.
+  unsigned int radius_max_;
 };
 
 #endif  // APPCOMMON_GRAPHICS_CIRCLE_DATA_SET_2D_H_
@@ -4,6 +4,8 @@
 #ifndef APPCOMMON_GRAPHICS_CIRCLE_RENDERER_2D_H_
 #define APPCOMMON_GRAPHICS_CIRCLE_RENDERER_2D_H_
 
+#include <vector>
+
 #include "wx/wx.h"
 
 #include "appcommon/graphics/circle_data_set_2d.h"
@@ -12,11 +14,16 @@
 /// \par OVERVIEW
 ///
 /// This class renders a line dataset onto a plot.
-class CircleRenderer2d : public Renderer2d {
+class CircleRenderer2d : public Renderer2dT<CircleDataSet2d> {
  public:
   /// \brief Constructor.
   CircleRenderer2d();
 
+  /// \brief Clones the renderer.
+  /// \return A new renderer that draws the same dataset with copies of the
+  ///   same styles. The caller takes ownership of the pointer.
+  Renderer2d* Clone() const override;
+
   /// \brief Draws the data onto the device context.
   /// \param[in] dc
   ///   The device context.
@@ -29,6 +36,21 @@ class CircleRenderer2d : public Renderer2d {
   void Draw(wxDC& dc, wxRect rc, const PlotAxis& axis_horizontal,
             const PlotAxis& axis_vertical) const override;
 
+  /// \brief Writes the data to a vector file.
+  /// \param[in] dc
+  ///   The device context that supplies the background colour.
+  /// \param[in] writer
+  ///   The vector file writer.
+  /// \param[in] rc
+  ///   The region to write to.
+  /// \param[in] axis_horizontal
+  ///   The horizontal plot axis.
+  /// \param[in] axis_vertical
+  ///   The vertical plot axis.
+  void Export(wxDC& dc, SvgWriter2d& writer, wxRect rc,
+              const PlotAxis& axis_horizontal,
+              const PlotAxis& axis_vertical) const override;
+
   /// \brief Gets the brush.
   /// \return The brush.
   const wxBrush* brush() const;
@@ -48,6 +70,25 @@ class CircleRenderer2d : public Renderer2d {
   void set_pen(const wxPen* pen);
 
  private:
+  /// \brief Transforms the visible circles to graphics coordinates.
+  /// \param[in] rc
+  ///   The dc region to draw onto.
+  /// \param[in] axis_horizontal
+  ///   The horizontal plot axis.
+  /// \param[in] axis_vertical
+  ///   The vertical plot axis.
+  /// \param[out] points
+  ///   The graphics points that are visible.
+  ///   These are wxPoint for drawing, or wxRealPoint for exporting without
+  ///   rounding.
+  /// \param[out] indexes
+  ///   The dataset element index of each visible point.
+  template <typename T>
+  void TransformCircles(const wxRect& rc, const PlotAxis& axis_horizontal,
+                        const PlotAxis& axis_vertical,
+                        std::vector<T>& points,
+                        std::vector<unsigned int>& indexes) const;
+
   /// \var brush_
   ///   The brush.
   /// The brush sets the inside color of the circle.
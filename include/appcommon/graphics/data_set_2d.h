@@ -4,9 +4,48 @@
 #ifndef APPCOMMON_GRAPHICS_DATA_SET_2D_H_
 #define APPCOMMON_GRAPHICS_DATA_SET_2D_H_
 
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "models/base/point.h"
+
+#include "appcommon/graphics/plot_axis.h"
+#include "appcommon/graphics/spatial_index_2d.h"
+
 /// \par OVERVIEW
 ///
 /// This class a set of data to be plotted.
+///
+/// \par SPATIAL INDEX
+///
+/// A dataset can optionally keep a spatial index of its elements. The index is
+/// built lazily the first time the visible elements are requested after the
+/// data changes. Renderers use it to only visit the elements that intersect the
+/// plot axes, so the draw cost depends on what is visible instead of the total
+/// dataset size.
+///
+/// \par VERSION
+///
+/// The dataset keeps a version counter that increases every time the data is
+/// modified. Observers such as the plot can cache values derived from the data
+/// and only recompute them when the version changes.
+///
+/// \par CONCURRENT READS
+///
+/// A dataset can be read by several threads at once, such as when a plot is
+/// rendered in parallel tiles, but only after Prepare() has built everything
+/// that would otherwise be built lazily during the reads. The dataset must not
+/// be modified while it is being read.
+///
+/// \par PICKING
+///
+/// Datasets can find the element nearest to a point, measuring the distance
+/// in graphics units so the result matches what is seen on screen. The
+/// candidate elements are found with the spatial index, which is built on
+/// demand for picking even if the dataset is not indexed, and is then kept
+/// until the data is modified or set_is_indexed(false) is called. Datasets
+/// that do not build an index check every element.
 class DataSet2d {
  public:
   /// \brief Constructor.
@@ -15,6 +54,19 @@ class DataSet2d {
   /// \brief Destructor.
   virtual ~DataSet2d();
 
+  /// \brief Gets the indexes of the elements that intersect the plot axes.
+  /// \param[in] axis_horizontal
+  ///   The horizontal plot axis.
+  /// \param[in] axis_vertical
+  ///   The vertical plot axis.
+  /// \param[out] indexes
+  ///   The element indexes, sorted in ascending order.
+  /// \return If the dataset is indexed. If not, the indexes are not modified
+  ///   and every element needs to be checked.
+  bool IndexesVisible(const PlotAxis& axis_horizontal,
+                      const PlotAxis& axis_vertical,
+                      std::vector<unsigned int>& indexes) const;
+
   /// \brief Gets the maximum x value.
   /// \return The maximum x value.
   virtual float MaxX() const = 0;
@@ -31,7 +83,130 @@ class DataSet2d {
   /// \return The minimum y value.
   virtual float MinY() const = 0;
 
+  /// \brief Gets the element nearest to a point.
+  /// \param[in] point
+  ///   The point, in data units.
+  /// \param[in] scale_x
+  ///   The factor that scales x data units to graphics units.
+  /// \param[in] scale_y
+  ///   The factor that scales y data units to graphics units.
+  /// \param[in] radius
+  ///   The maximum distance, in graphics units.
+  /// \param[out] index
+  ///   The element index.
+  /// \param[out] distance
+  ///   The distance to the element, in graphics units.
+  /// \return If an element was found within the radius. This is always false
+  ///   for datasets that do not support picking.
+  virtual bool Nearest(const Point2d<float>& point, const float& scale_x,
+                       const float& scale_y, const float& radius,
+                       unsigned int& index, float& distance) const;
+
+  /// \brief Builds any lazily built structures, such as the spatial index.
+  /// Derived datasets with additional lazily built structures must override
+  /// this and call the base implementation.
+  virtual void Prepare() const;
+
+  /// \brief Gets the version.
+  /// \return The version, which increases every time the data is modified.
+  uint64_t version() const;
+
+  /// \brief Gets if the dataset keeps a spatial index.
+  /// \return If the dataset keeps a spatial index.
+  bool is_indexed() const;
+
+  /// \brief Sets if the dataset keeps a spatial index.
+  /// \param[in] is_indexed
+  ///   An indicator that determines if a spatial index is kept.
+  void set_is_indexed(const bool& is_indexed);
+
  protected:
+  /// \brief Gets the distance from a point to a line segment.
+  /// \param[in] point
+  ///   The point, in data units.
+  /// \param[in] x0
+  ///   The segment start point x value.
+  /// \param[in] y0
+  ///   The segment start point y value.
+  /// \param[in] x1
+  ///   The segment end point x value.
+  /// \param[in] y1
+  ///   The segment end point y value.
+  /// \param[in] scale_x
+  ///   The factor that scales x data units to graphics units.
+  /// \param[in] scale_y
+  ///   The factor that scales y data units to graphics units.
+  /// \return The distance, in graphics units.
+  static float DistanceSegment(const Point2d<float>& point,
+                               const float& x0, const float& y0,
+                               const float& x1, const float& y1,
+                               const float& scale_x, const float& scale_y);
+
+  /// \brief Extends the cached limits to include a point.
+  /// \param[in] x
+  ///   The x value.
+  /// \param[in] y
+  ///   The y value.
+  void ExtendLimits(const float& x, const float& y);
+
+  /// \brief Gets the indexes of the elements that may be near a point.
+  /// \param[in] point
+  ///   The point, in data units.
+  /// \param[in] scale_x
+  ///   The factor that scales x data units to graphics units.
+  /// \param[in] scale_y
+  ///   The factor that scales y data units to graphics units.
+  /// \param[in] radius
+  ///   The distance, in graphics units.
+  /// \param[out] indexes
+  ///   The element indexes, sorted in ascending order.
+  /// \return If the dataset builds an index. If not, the indexes are not
+  ///   modified and every element needs to be checked.
+  /// The spatial index is built if it is outdated, even if the dataset is not
+  /// indexed.
+  bool IndexesPick(const Point2d<float>& point, const float& scale_x,
+                   const float& scale_y, const float& radius,
+                   std::vector<unsigned int>& indexes) const;
+
+  /// \brief Gets the indexes of the elements that intersect a region.
+  /// \param[in] region
+  ///   The region, in data units.
+  /// \param[out] indexes
+  ///   The element indexes, sorted in ascending order.
+  /// \return If the dataset is indexed. If not, the indexes are not modified
+  ///   and every element needs to be checked.
+  bool IndexesRegion(const BoundingBox2d& region,
+                     std::vector<unsigned int>& indexes) const;
+
+  /// \brief Resets the cached limits to an empty dataset.
+  void ResetLimits();
+
+  /// \brief Updates the spatial index.
+  /// \return If the index was built. If not, the dataset is treated as not
+  ///   indexed and every element is checked.
+  /// Derived datasets that support indexing must override this and build the
+  /// index from the element bounding boxes. The base dataset does not build
+  /// an index.
+  virtual bool UpdateIndex() const;
+
+  /// \var index_
+  ///   The spatial index of the elements.
+  mutable SpatialIndex2d index_;
+
+  /// \var is_indexed_
+  ///   An indicator that determines if the spatial index is used.
+  bool is_indexed_;
+
+  /// \var is_updated_index_
+  ///   An indicator that tells if the spatial index has been updated. The
+  ///   index can be updated for picking even if the dataset is not indexed.
+  mutable bool is_updated_index_;
+
+  /// \var version_
+  ///   The version of the data. Derived datasets must increment this whenever
+  ///   the data is modified.
+  uint64_t version_;
+
   /// \var x_max_
   ///   The maximum x value.
   mutable float x_max_;
@@ -0,0 +1,230 @@
+// This is free and unencumbered software released into the public domain.
+// For more information, please refer to <http://unlicense.org/>
+
+#ifndef APPCOMMON_GRAPHICS_GRAPHICS_KERNEL_2D_H_
+#define APPCOMMON_GRAPHICS_GRAPHICS_KERNEL_2D_H_
+
+#include <cstddef>
+#include <vector>
+
+#include "wx/wx.h"
+
+#include "appcommon/graphics/plot_axis.h"
+
+/// \par OVERVIEW
+///
+/// This class transforms whole arrays of data coordinates into graphics
+/// coordinates, culling and clipping them to the plot axes in one pass.
+///
+/// \par TRANSFORM
+///
+/// The axis limits and graphics scale are solved once when the kernel is
+/// constructed, so each coordinate only needs a subtract and a multiply.
+/// Graphics coordinates are truncated to integers for drawing, matching
+/// Renderer2d::DataToGraphics(). The overloads that output wxRealPoint keep the
+/// fractional coordinates, which is used for exporting.
+///
+/// \par CLIPPING
+///
+/// Segments are clipped with the Liang-Barsky algorithm, which solves for the
+/// visible parameter range of each segment without branching on which edges
+/// are crossed. Segments that are entirely outside of the axes are removed.
+///
+/// \par VECTORIZATION
+///
+/// When compiled for a target with SSE2 (all x86-64 targets), four elements
+/// are processed per instruction. Any remaining elements, and other targets,
+/// use a scalar path with the same math.
+class GraphicsKernel2d {
+ public:
+  /// \brief Constructor.
+  /// \param[in] axis_horizontal
+  ///   The horizontal plot axis.
+  /// \param[in] axis_vertical
+  ///   The vertical plot axis.
+  /// \param[in] rc
+  ///   The dc region to draw onto.
+  GraphicsKernel2d(const PlotAxis& axis_horizontal,
+                   const PlotAxis& axis_vertical, const wxRect& rc);
+
+  /// \brief Destructor.
+  ~GraphicsKernel2d();
+
+  /// \brief Transforms and clips line segments.
+  /// \param[in] x0
+  ///   The start point x values.
+  /// \param[in] y0
+  ///   The start point y values.
+  /// \param[in] x1
+  ///   The end point x values.
+  /// \param[in] y1
+  ///   The end point y values.
+  /// \param[in] count
+  ///   The number of segments.
+  /// \param[in,out] points
+  ///   The graphics points. Each visible segment is appended as consecutive
+  ///   start and end points.
+  void ClipSegments(const float* x0, const float* y0,
+                    const float* x1, const float* y1,
+                    const std::size_t& count,
+                    std::vector<wxPoint>& points) const;
+
+  /// \brief Transforms and clips line segments without rounding.
+  /// \param[in] x0
+  ///   The start point x values.
+  /// \param[in] y0
+  ///   The start point y values.
+  /// \param[in] x1
+  ///   The end point x values.
+  /// \param[in] y1
+  ///   The end point y values.
+  /// \param[in] count
+  ///   The number of segments.
+  /// \param[in,out] points
+  ///   The graphics points. Each visible segment is appended as consecutive
+  ///   start and end points.
+  /// This always uses the scalar path.
+  void ClipSegments(const float* x0, const float* y0,
+                    const float* x1, const float* y1,
+                    const std::size_t& count,
+                    std::vector<wxRealPoint>& points) const;
+
+  /// \brief Transforms and clips line segments without vectorization.
+  /// \param[in] x0
+  ///   The start point x values.
+  /// \param[in] y0
+  ///   The start point y values.
+  /// \param[in] x1
+  ///   The end point x values.
+  /// \param[in] y1
+  ///   The end point y values.
+  /// \param[in] index_begin
+  ///   The first segment index.
+  /// \param[in] index_end
+  ///   The segment index past the last segment.
+  /// \param[in,out] points
+  ///   The graphics points.
+  /// This produces the same points as ClipSegments(), and is public so the
+  /// vectorized path can be measured against it.
+  void ClipSegmentsScalar(const float* x0, const float* y0,
+                          const float* x1, const float* y1,
+                          const std::size_t& index_begin,
+                          const std::size_t& index_end,
+                          std::vector<wxPoint>& points) const;
+
+  /// \brief Gets if the kernel is vectorized.
+  /// \return If the kernel is vectorized.
+  static bool IsVectorized();
+
+  /// \brief Transforms and culls points.
+  /// \param[in] x
+  ///   The x values.
+  /// \param[in] y
+  ///   The y values.
+  /// \param[in] margins
+  ///   The distance (in data units) that each point can be outside of the
+  ///   axes and still be kept, such as a circle radius. This is optional and
+  ///   can be null.
+  /// \param[in] count
+  ///   The number of points.
+  /// \param[out] points
+  ///   The graphics points that are visible.
+  /// \param[out] indexes
+  ///   The input array index of each visible point.
+  void TransformPoints(const float* x, const float* y, const float* margins,
+                       const std::size_t& count,
+                       std::vector<wxPoint>& points,
+                       std::vector<unsigned int>& indexes) const;
+
+  /// \brief Transforms and culls points without rounding.
+  /// \param[in] x
+  ///   The x values.
+  /// \param[in] y
+  ///   The y values.
+  /// \param[in] margins
+  ///   The optional point margins, in data units.
+  /// \param[in] count
+  ///   The number of points.
+  /// \param[out] points
+  ///   The graphics points that are visible.
+  /// \param[out] indexes
+  ///   The input array index of each visible point.
+  /// This always uses the scalar path.
+  void TransformPoints(const float* x, const float* y, const float* margins,
+                       const std::size_t& count,
+                       std::vector<wxRealPoint>& points,
+                       std::vector<unsigned int>& indexes) const;
+
+ private:
+  /// \brief Transforms and clips a range of line segments without
+  ///   vectorization.
+  /// \param[in] x0
+  ///   The start point x values.
+  /// \param[in] y0
+  ///   The start point y values.
+  /// \param[in] x1
+  ///   The end point x values.
+  /// \param[in] y1
+  ///   The end point y values.
+  /// \param[in] index_begin
+  ///   The first segment index.
+  /// \param[in] index_end
+  ///   The segment index past the last segment.
+  /// \param[in,out] points
+  ///   The graphics points, which are either wxPoint or wxRealPoint.
+  template <typename T>
+  void ClipSegmentsRange(const float* x0, const float* y0,
+                         const float* x1, const float* y1,
+                         const std::size_t& index_begin,
+                         const std::size_t& index_end,
+                         std::vector<T>& points) const;
+
+  /// \brief Transforms and culls points without vectorization.
+  /// \param[in] x
+  ///   The x values.
+  /// \param[in] y
+  ///   The y values.
+  /// \param[in] margins
+  ///   The optional point margins.
+  /// \param[in] index_begin
+  ///   The first point index.
+  /// \param[in] index_end
+  ///   The point index past the last point.
+  /// \param[in,out] points
+  ///   The graphics points, which are either wxPoint or wxRealPoint.
+  /// \param[in,out] indexes
+  ///   The input array indexes.
+  template <typename T>
+  void TransformPointsScalar(const float* x, const float* y,
+                             const float* margins,
+                             const std::size_t& index_begin,
+                             const std::size_t& index_end,
+                             std::vector<T>& points,
+                             std::vector<unsigned int>& indexes) const;
+
+  /// \var scale_x_
+  ///   The factor that scales x data units to graphics units.
+  float scale_x_;
+
+  /// \var scale_y_
+  ///   The factor that scales y data units to graphics units.
+  float scale_y_;
+
+  /// \var x_max_
+  ///   The maximum visible x value.
+  float x_max_;
+
+  /// \var x_min_
+  ///   The minimum visible x value.
+  float x_min_;
+
+  /// \var y_max_
+  ///   The maximum visible y value.
+  float y_max_;
+
+  /// \var y_min_
+  ///   The minimum visible y value.
+  float y_min_;
+};
+
+#endif  // APPCOMMON_GRAPHICS_GRAPHICS_KERNEL_2D_H_
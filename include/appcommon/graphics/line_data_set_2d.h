@@ -4,11 +4,15 @@
 #ifndef APPCOMMON_GRAPHICS_LINE_DATA_SET_2D_H_
 #define APPCOMMON_GRAPHICS_LINE_DATA_SET_2D_H_
 
+#include <cstddef>
 #include <list>
+#include <vector>
 
 #include "models/base/point.h"
 
 #include "appcommon/graphics/data_set_2d.h"
+#include "appcommon/graphics/min_max_pyramid_2d.h"
+#include "appcommon/graphics/plot_axis.h"
 
 /// \par OVERVIEW
 ///
@@ -23,9 +27,64 @@ struct Line2d {
   Point2d<float> p1;
 };
 
+/// \par OVERVIEW
+///
+/// This struct is a read-only view of the contiguous line storage. Each array
+/// contains size values, and the same index refers to the same line in every
+/// array.
+///
+/// The view is invalidated when lines are added to or cleared from the dataset.
+struct LineDataSpan2d {
+  /// \var size
+  ///   The number of lines.
+  std::size_t size;
+
+  /// \var x0
+  ///   The start point x values.
+  const float* x0;
+
+  /// \var x1
+  ///   The end point x values.
+  const float* x1;
+
+  /// \var y0
+  ///   The start point y values.
+  const float* y0;
+
+  /// \var y1
+  ///   The end point y values.
+  const float* y1;
+};
+
 /// \par OVERVIEW
 ///
 /// This class represents a set of 2D lines.
+///
+/// \par STORAGE
+///
+/// The lines are stored in a structure-of-arrays layout, with one packed float
+/// array for each point component. This avoids a heap allocation per line and
+/// lets renderers stream through the coordinates sequentially. Use Reserve()
+/// and AddRange() when the number of lines is known ahead of time.
+///
+/// \par POINTER ADAPTER
+///
+/// The pointer based Add() and data() functions are kept for existing callers.
+/// Added pointers are kept by the dataset, and their lines are copied into the
+/// contiguous storage. The pointer list returned by data() holds the added
+/// pointers, and generates a line for each line that was added by value. The
+/// contiguous storage is what is drawn, so Span() should be preferred for new
+/// code.
+///
+/// \par LEVEL OF DETAIL
+///
+/// The dataset can optionally keep a min/max pyramid of the lines, which is
+/// built lazily the first time it is queried after the data changes. When
+/// zoomed out, renderers can use it to draw a vertical span for each pixel
+/// column instead of every line, so the draw cost is bounded by the window
+/// width. This is intended for lines that form a single curve along the x
+/// axis, such as a profile or time series. Overlapping curves would be merged
+/// into a single band.
 class LineDataSet2d : public DataSet2d {
  public:
   /// \brief Constructor.
@@ -37,12 +96,62 @@ class LineDataSet2d : public DataSet2d {
   /// \brief Adds a line to the dataset.
   /// \param[in] line
   ///   The line.
-  /// This class will take ownership of the pointer.
+  /// This class will take ownership of the pointer, which stays valid until
+  /// the dataset is cleared. The line is copied into the contiguous storage,
+  /// so later changes made through the pointer are not drawn.
   void Add(const Line2d* line);
 
+  /// \brief Adds a line to the dataset.
+  /// \param[in] line
+  ///   The line.
+  void Add(const Line2d& line);
+
+  /// \brief Adds multiple lines to the dataset.
+  /// \param[in] lines
+  ///   The lines.
+  /// \param[in] count
+  ///   The number of lines.
+  void AddRange(const Line2d* lines, const std::size_t& count);
+
+  /// \brief Adds multiple lines to the dataset.
+  /// \param[in] x0
+  ///   The start point x values.
+  /// \param[in] y0
+  ///   The start point y values.
+  /// \param[in] x1
+  ///   The end point x values.
+  /// \param[in] y1
+  ///   The end point y values.
+  /// \param[in] count
+  ///   The number of values in each array.
+  void AddRange(const float* x0, const float* y0,
+                const float* x1, const float* y1,
+                const std::size_t& count);
+
   /// \brief Clears all of the stored lines.
   void Clear();
 
+  /// \brief Gets the decimated vertical extents for columns along the
+  ///   horizontal axis.
+  /// \param[in] axis_horizontal
+  ///   The horizontal plot axis.
+  /// \param[in] num_columns
+  ///   The number of columns to divide the axis into, typically the width in
+  ///   pixels.
+  /// \param[out] columns
+  ///   The vertical extents of the lines within each column.
+  /// \return The approximate number of lines within the axis range. This is
+  ///   zero if the dataset is not decimated, or if the axis is zoomed in past
+  ///   the pyramid resolution.
+  std::size_t Decimate(const PlotAxis& axis_horizontal, const int& num_columns,
+                       std::vector<MinMaxBin2d>& columns) const;
+
+  /// \brief Gets a line.
+  /// \param[in] index
+  ///   The line index.
+  /// \return The line.
+  Line2d Line(const std::size_t& index) const;
+
   /// \brief Gets the maximum x value.
   /// \return The maximum x value.
   float MaxX() const override;
@@ -59,21 +168,104 @@ class LineDataSet2d : public DataSet2d {
   /// \return The minimum y value.
   float MinY() const override;
 
+  /// \brief Gets the element nearest to a point.
+  /// \param[in] point
+  ///   The point, in data units.
+  /// \param[in] scale_x
+  ///   The factor that scales x data units to graphics units.
+  /// \param[in] scale_y
+  ///   The factor that scales y data units to graphics units.
+  /// \param[in] radius
+  ///   The maximum distance, in graphics units.
+  /// \param[out] index
+  ///   The line index.
+  /// \param[out] distance
+  ///   The distance to the line, in graphics units.
+  /// \return If a line was found within the radius.
+  bool Nearest(const Point2d<float>& point, const float& scale_x,
+               const float& scale_y, const float& radius,
+               unsigned int& index, float& distance) const override;
+
+  /// \brief Builds the spatial index and min/max pyramid, if enabled.
+  void Prepare() const override;
+
+  /// \brief Reserves storage for lines.
+  /// \param[in] count
+  ///   The total number of lines to reserve storage for.
+  void Reserve(const std::size_t& count);
+
+  /// \brief Gets the number of lines.
+  /// \return The number of lines.
+  std::size_t Size() const;
+
+  /// \brief Gets a view of the contiguous line storage.
+  /// \return A view of the contiguous line storage.
+  LineDataSpan2d Span() const;
+
+  /// \brief Gets if the dataset keeps a min/max pyramid for decimation.
+  /// \return If the dataset keeps a min/max pyramid for decimation.
+  bool is_decimated() const;
+
+  /// \brief Sets if the dataset keeps a min/max pyramid for decimation.
+  /// \param[in] is_decimated
+  ///   An indicator that determines if a min/max pyramid is kept.
+  void set_is_decimated(const bool& is_decimated);
+
   /// \brief Gets the data.
   /// \return The data.
+  /// The first call allocates a line for every line that was added by value,
+  /// and later calls only allocate lines for the new additions. The pointers
+  /// in the list stay valid until the dataset is cleared, which invalidates
+  /// all of them. Use Span() instead when possible.
   const std::list<const Line2d*>* data() const;
 
  private:
-  /// \brief Updates the cached values.
-  void Update() const;
+  /// \brief Clears the line pointer list used by data().
+  void ClearAdapter() const;
+
+  /// \brief Appends a line pointer to data() for each line that does not have
+  ///   one.
+  void UpdateAdapter() const;
+
+  /// \brief Updates the spatial index.
+  /// \return If the index was built.
+  bool UpdateIndex() const override;
+
+  /// \brief Updates the min/max pyramid, if it is outdated.
+  void UpdatePyramid() const;
 
   /// \var data_
-  ///   The line data.
-  std::list<const Line2d*> data_;
+  ///   The line pointers for data(), in line order. These are the added
+  ///   pointers and the generated lines, which are all owned by the dataset.
+  mutable std::list<const Line2d*> data_;
+
+  /// \var is_decimated_
+  ///   An indicator that determines if the min/max pyramid is used.
+  bool is_decimated_;
+
+  /// \var is_updated_pyramid_
+  ///   An indicator that tells if the min/max pyramid is updated.
+  mutable bool is_updated_pyramid_;
+
+  /// \var pyramid_
+  ///   The min/max pyramid used for decimation.
+  mutable MinMaxPyramid2d pyramid_;
+
+  /// \var x0_
+  ///   The start point x values.
+  std::vector<float> x0_;
+
+  /// \var x1_
+  ///   The end point x values.
+  std::vector<float> x1_;
+
+  /// \var y0_
+  ///   The start point y values.
+  std::vector<float> y0_;
 
-  /// \var is_updated_
-  ///   An indicator that tells if the cached values have been updated.
-  mutable bool is_updated_;
+  /// \var y1_
+  ///   The end point y values.
+  std::vector<float> y1_;
 };
 
 #endif  // APPCOMMON_GRAPHICS_LINE_DATA_SET_2D_H_
@@ -4,6 +4,8 @@
 #ifndef APPCOMMON_GRAPHICS_LINE_RENDERER_2D_H_
 #define APPCOMMON_GRAPHICS_LINE_RENDERER_2D_H_
 
+#include <vector>
+
 #include "wx/wx.h"
 
 #include "appcommon/graphics/line_data_set_2d.h"
@@ -12,11 +14,16 @@
 /// \par OVERVIEW
 ///
 /// This class renders a line dataset onto a plot.
-class LineRenderer2d : public Renderer2d {
+class LineRenderer2d : public Renderer2dT<LineDataSet2d> {
  public:
   /// \brief Constructor.
   LineRenderer2d();
 
+  /// \brief Clones the renderer.
+  /// \return A new renderer that draws the same dataset with copies of the
+  ///   same styles. The caller takes ownership of the pointer.
+  Renderer2d* Clone() const override;
+
   /// \brief Draws the data onto the device context.
   /// \param[in] dc
   ///   The device context.
@@ -29,6 +36,21 @@ class LineRenderer2d : public Renderer2d {
   void Draw(wxDC& dc, wxRect rc, const PlotAxis& axis_horizontal,
             const PlotAxis& axis_vertical) const override;
 
+  /// \brief Writes the data to a vector file.
+  /// \param[in] dc
+  ///   The device context that supplies the background colour.
+  /// \param[in] writer
+  ///   The vector file writer.
+  /// \param[in] rc
+  ///   The region to write to.
+  /// \param[in] axis_horizontal
+  ///   The horizontal plot axis.
+  /// \param[in] axis_vertical
+  ///   The vertical plot axis.
+  void Export(wxDC& dc, SvgWriter2d& writer, wxRect rc,
+              const PlotAxis& axis_horizontal,
+              const PlotAxis& axis_vertical) const override;
+
   /// \brief Gets the pen.
   /// \return The pen.
   const wxPen* pen() const;
@@ -39,6 +61,37 @@ class LineRenderer2d : public Renderer2d {
   void set_pen(const wxPen* pen);
 
  private:
+  /// \brief Transforms decimated columns to graphics coordinates.
+  /// \param[in] rc
+  ///   The dc region to draw onto.
+  /// \param[in] axis_vertical
+  ///   The vertical plot axis.
+  /// \param[in] columns
+  ///   The vertical extents of the lines for each pixel column.
+  /// \param[out] points
+  ///   The column spans, stored as consecutive start and end points.
+  ///   These are wxPoint for drawing, or wxRealPoint for exporting without
+  ///   rounding.
+  /// Each column is a vertical span, and adjacent spans are joined when they
+  /// overlap so the columns form a single polyline.
+  template <typename T>
+  static void TransformColumns(const wxRect& rc, const PlotAxis& axis_vertical,
+                               const std::vector<MinMaxBin2d>& columns,
+                               std::vector<T>& points);
+
+  /// \brief Transforms the visible lines to graphics coordinates.
+  /// \param[in] rc
+  ///   The dc region to draw onto.
+  /// \param[in] axis_horizontal
+  ///   The horizontal plot axis.
+  /// \param[in] axis_vertical
+  ///   The vertical plot axis.
+  /// \param[out] points
+  ///   The visible segments, stored as consecutive start and end points.
+  void TransformLines(const wxRect& rc, const PlotAxis& axis_horizontal,
+                      const PlotAxis& axis_vertical,
+                      std::vector<wxPoint>& points) const;
+
   /// \var pen_
   ///   The pen.
   const wxPen* pen_;
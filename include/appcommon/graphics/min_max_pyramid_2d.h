@@ -0,0 +1,173 @@
+// This is free and unencumbered software released into the public domain.
+// For more information, please refer to <http://unlicense.org/>
+
+#ifndef APPCOMMON_GRAPHICS_MIN_MAX_PYRAMID_2D_H_
+#define APPCOMMON_GRAPHICS_MIN_MAX_PYRAMID_2D_H_
+
+#include <cstddef>
+#include <vector>
+
+/// \par OVERVIEW
+///
+/// This struct is the vertical extent of the lines within a horizontal bin.
+struct MinMaxBin2d {
+  /// \var count
+  ///   The number of lines that pass through the bin.
+  unsigned int count;
+
+  /// \var y_max
+  ///   The maximum y value.
+  float y_max;
+
+  /// \var y_min
+  ///   The minimum y value.
+  float y_min;
+};
+
+/// \par OVERVIEW
+///
+/// This class is a multi-resolution pyramid of the vertical min/max extents of
+/// a set of lines, binned along the horizontal axis.
+///
+/// \par LEVELS
+///
+/// The first level divides the horizontal extents of the lines into a power of
+/// two number of bins. Every following level halves the number of bins, until a
+/// single bin remains.
+///
+/// Each line is inserted into the finest level where it only passes through a
+/// few bins, using the y values where the line enters and exits each bin. The
+/// build cost therefore does not depend on the line lengths. The bins of each
+/// level are then merged into the next coarser level, so a bin includes all of
+/// the lines that were inserted at or below its level.
+///
+/// Lines that are inserted above the first level are also kept, because their
+/// bins can be wider than a query column.
+///
+/// \par COLUMNS
+///
+/// A query divides a horizontal range into columns (typically one per pixel)
+/// and picks the coarsest level where several bins fit within a column. Each
+/// column then only needs to merge a few bins, so the query cost depends on the
+/// number of columns and not the number of lines.
+///
+/// The lines that were inserted into levels coarser than the selected level are
+/// interpolated directly into the columns they pass through. These lines are
+/// long compared to a column, so there are few of them within a range.
+class MinMaxPyramid2d {
+ public:
+  /// \brief Constructor.
+  MinMaxPyramid2d();
+
+  /// \brief Destructor.
+  ~MinMaxPyramid2d();
+
+  /// \brief Builds the pyramid.
+  /// \param[in] x0
+  ///   The start point x values.
+  /// \param[in] y0
+  ///   The start point y values.
+  /// \param[in] x1
+  ///   The end point x values.
+  /// \param[in] y1
+  ///   The end point y values.
+  /// \param[in] size
+  ///   The number of lines.
+  void Build(const float* x0, const float* y0,
+             const float* x1, const float* y1,
+             const std::size_t& size);
+
+  /// \brief Clears the pyramid.
+  void Clear();
+
+  /// \brief Gets the vertical extents for columns along a horizontal range.
+  /// \param[in] x_min
+  ///   The minimum x value of the range.
+  /// \param[in] x_max
+  ///   The maximum x value of the range.
+  /// \param[in] num_columns
+  ///   The number of equal width columns to divide the range into.
+  /// \param[out] columns
+  ///   The column extents. Columns that do not contain any lines have a count
+  ///   of zero.
+  /// \return The approximate number of lines within the range. This is zero if
+  ///   the pyramid is not detailed enough to resolve the columns.
+  std::size_t Query(const float& x_min, const float& x_max,
+                    const int& num_columns,
+                    std::vector<MinMaxBin2d>& columns) const;
+
+ private:
+  /// \par OVERVIEW
+  ///
+  /// This struct is a line that is kept by a pyramid level, with its points
+  /// ordered left to right.
+  struct Segment {
+    /// \var xa
+    ///   The left point x value.
+    float xa;
+
+    /// \var xb
+    ///   The right point x value.
+    float xb;
+
+    /// \var ya
+    ///   The left point y value.
+    float ya;
+
+    /// \var yb
+    ///   The right point y value.
+    float yb;
+  };
+
+  /// \brief Adds a line to the bins it passes through within a level.
+  /// \param[in] segment
+  ///   The line.
+  /// \param[in] index_level
+  ///   The level index.
+  void AddToLevel(const Segment& segment, const std::size_t& index_level);
+
+  /// \brief Adds y values to a bin.
+  /// \param[in] ya
+  ///   The first y value.
+  /// \param[in] yb
+  ///   The second y value.
+  /// \param[in,out] bin
+  ///   The bin.
+  static void AddToBin(const float& ya, const float& yb, MinMaxBin2d& bin);
+
+  /// \brief Merges a bin into another.
+  /// \param[in] bin
+  ///   The bin to merge.
+  /// \param[in,out] bin_merged
+  ///   The bin that is merged into.
+  static void MergeBin(const MinMaxBin2d& bin, MinMaxBin2d& bin_merged);
+
+  /// \brief Gets the first level bin index that contains the x value.
+  /// \param[in] x
+  ///   The x value.
+  /// \return The bin index, clamped to the first level.
+  std::size_t IndexBin(const float& x) const;
+
+  /// \var levels_
+  ///   The pyramid levels, starting with the most detailed.
+  std::vector<std::vector<MinMaxBin2d>> levels_;
+
+  /// \var segments_
+  ///   The lines that were inserted into each level, sorted by the left x
+  ///   value. The first level does not keep its lines.
+  std::vector<std::vector<Segment>> segments_;
+
+  /// \var width_bin_
+  ///   The width of a bin in the first level.
+  float width_bin_;
+
+  /// \var x_max_
+  ///   The maximum x value of the lines.
+  float x_max_;
+
+  /// \var x_min_
+  ///   The minimum x value of the lines.
+  float x_min_;
+};
+
+#endif  // APPCOMMON_GRAPHICS_MIN_MAX_PYRAMID_2D_H_
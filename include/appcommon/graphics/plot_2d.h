@@ -4,7 +4,11 @@
 #ifndef APPCOMMON_GRAPHICS_PLOT_2D_H_
 #define APPCOMMON_GRAPHICS_PLOT_2D_H_
 
+#include <atomic>  // NOLINT
+#include <cstdint>
 #include <list>
+#include <string>
+#include <vector>
 
 #include "models/base/point.h"
 #include "wx/wx.h"
@@ -33,6 +37,49 @@ struct Plot2dDataLimits {
   float y_min;
 };
 
+/// \par OVERVIEW
+///
+/// This struct is an element that has been picked from the plot.
+struct Plot2dPick {
+  /// \var dataset
+  ///   The dataset that contains the element.
+  const DataSet2d* dataset;
+
+  /// \var distance
+  ///   The distance from the pick point to the element, in graphics units.
+  float distance;
+
+  /// \var index
+  ///   The element index within the dataset.
+  unsigned int index;
+
+  /// \var renderer
+  ///   The renderer that draws the dataset.
+  const Renderer2d* renderer;
+};
+
+/// \par OVERVIEW
+///
+/// This struct contains the values that transform plot data coordinates to
+/// graphics coordinates.
+struct Plot2dTransform {
+  /// \var offset
+  ///   The graphics origin defined in the data coordinate system.
+  Point2d<float> offset;
+
+  /// \var scale
+  ///   The general scale factor.
+  float scale;
+
+  /// \var scale_x
+  ///   The x-axis scale factor.
+  float scale_x;
+
+  /// \var scale_y
+  ///   The y-axis scale factor.
+  float scale_y;
+};
+
 /// \par OVERVIEW
 ///
 /// This class is a 2D plot. It accepts data/renderers and renders them onto a
@@ -84,6 +131,27 @@ struct Plot2dDataLimits {
 /// \par ZOOM
 ///
 /// This plot supports zooming in/out.
+///
+/// \par PARALLEL RENDERING
+///
+/// The plot can be split into screen space tiles that are rendered by several
+/// threads at once. Each thread draws its tiles into separate images with its
+/// own clones of the renderers, and the images are then drawn onto the device
+/// context by the calling thread. A full redraw of a large plot scales with
+/// the number of cores, as long as the datasets are indexed so each tile only
+/// visits its own elements.
+///
+/// \par HEADLESS RENDERING
+///
+/// The plot can be rendered directly into an image for export, without a
+/// window.
+///
+/// \par VECTOR EXPORT
+///
+/// The plot can be streamed to an SVG file. Each renderer writes its visible
+/// elements with the same culling and clipping that it uses to draw, and the
+/// elements are written to the file as they are generated, so large datasets
+/// are exported without holding the document in memory.
 class Plot2d {
  public:
   /// \brief Constructor.
@@ -100,6 +168,53 @@ class Plot2d {
   /// \brief Clears the renderers.
   void ClearRenderers();
 
+  /// \brief Clones the plot.
+  /// \return A new plot with the same transform and background, and clones of
+  ///   the renderers. The caller takes ownership of the pointer. This is a
+  ///   null pointer if any renderer does not support cloning.
+  /// The clone does not share any styles with this plot, so it can be
+  /// rendered on another thread while this plot is used. It must be created
+  /// on the thread that owns the renderer styles, and the datasets must not
+  /// be modified while the clone is rendered.
+  Plot2d* Clone() const;
+
+  /// \brief Creates a device context that draws into an image.
+  /// \param[in] image
+  ///   The image, which must outlive the device context. The image is only
+  ///   updated once the device context is deleted.
+  /// \param[in] background
+  ///   The background colour.
+  /// \return The device context, which the caller takes ownership of. This is
+  ///   a null pointer if a graphics context could not be created.
+  /// The default pen, brush, font, and colours of a new device context share
+  /// reference counts with the stock objects, which are not thread safe. These
+  /// are replaced with new objects that are built from plain values, so the
+  /// device context can be handed to another thread.
+  static wxDC* CreateDcImage(wxImage& image, const wxColour& background);
+
+  /// \brief Exports the plot to an SVG file.
+  /// \param[in] filename
+  ///   The file path. An existing file is overwritten.
+  /// \param[in] width
+  ///   The drawing width, in graphics units.
+  /// \param[in] height
+  ///   The drawing height, in graphics units.
+  /// \return If the file was written successfully. This is false if the size
+  ///   is not positive.
+  /// The plot is fitted to the drawing size if fitting is enabled, the same
+  /// as a render. Text is measured with the default font, and renderers that
+  /// do not support exporting are skipped.
+  bool ExportSvg(const std::string& filename, const int& width,
+                 const int& height) const;
+
+  /// \brief Fits the plot data to the graphics rect, if fitting is enabled.
+  /// \param[in] rc
+  ///   The rectangle of the rendering region.
+  /// This updates the offset and scale, and is done automatically when
+  /// rendering. It can be called beforehand to get the offset and scale that
+  /// the next render will use.
+  void FitToRect(const wxRect& rc) const;
+
   /// \brief Gets the plot data limits.
   /// \return The plot data limits.
   Plot2dDataLimits LimitsData() const;
@@ -108,6 +223,27 @@ class Plot2d {
   /// \return If the plot has any renderers.
   bool HasRenderers() const;
 
+  /// \brief Picks the element nearest to a graphics coordinate.
+  /// \param[in] point
+  ///   The graphics coordinate, relative to the render rect origin.
+  /// \param[in] radius
+  ///   The maximum distance to the element, in graphics units.
+  /// \param[out] pick
+  ///   The nearest element.
+  /// \return If an element was found within the radius.
+  /// Each dataset is searched with its own spatial index instead of one index
+  /// that is shared by all of the datasets. A shared index would need to be
+  /// rebuilt whenever any dataset changes, while a dataset index is only
+  /// rebuilt for the dataset that changed. The dataset index is built on
+  /// demand by the first pick, even if the dataset is not indexed, so each
+  /// following pick only checks the nearby elements. If elements are equally
+  /// near, the last drawn is picked.
+  ///
+  /// A dataset index that is outdated is rebuilt by the search. If the plot is
+  /// also rendered on another thread, Prepare() must be called before that
+  /// render starts, so the search only reads the indexed datasets.
+  bool Pick(const wxPoint& point, const float& radius, Plot2dPick& pick) const;
+
   /// \brief Translates a data coordinate to a graphics coordinate.
   /// \param[in] point_data
   ///   The data coordinate.
@@ -120,6 +256,11 @@ class Plot2d {
   /// \return The data coordinate.
   Point2d<float> PointGraphicsToData(const wxPoint& point_graphics) const;
 
+  /// \brief Prepares the renderer datasets for concurrent reads.
+  /// This builds any outdated dataset indexes, so the datasets are only read
+  /// until they are modified again.
+  void Prepare() const;
+
   /// \brief Renders the plot.
   /// \param[in] dc
   ///   The device context.
@@ -127,6 +268,96 @@ class Plot2d {
   ///   The rectangle of the rendering region.
   void Render(wxDC& dc, wxRect rc) const;
 
+  /// \brief Renders the plot renderers with fixed axes.
+  /// \param[in] dc
+  ///   The device context.
+  /// \param[in] rc
+  ///   The rectangle of the rendering region.
+  /// \param[in] axis_horizontal
+  ///   The horizontal plot axis, which spans the rectangle width.
+  /// \param[in] axis_vertical
+  ///   The vertical plot axis, which spans the rectangle height.
+  /// \param[in] is_cancelled
+  ///   An optional indicator that is checked between renderers. The render
+  ///   stops early if it is set.
+  /// \return If all of the renderers were drawn.
+  /// This is the same as RenderTransformed(), but lets the caller solve the
+  /// axes with more precision than the float transform offset.
+  bool RenderAxes(wxDC& dc, const wxRect& rc, const PlotAxis& axis_horizontal,
+                  const PlotAxis& axis_vertical,
+                  const std::atomic<bool>* is_cancelled) const;
+
+  /// \brief Renders the plot with several threads.
+  /// \param[in] dc
+  ///   The device context.
+  /// \param[in] rc
+  ///   The rectangle of the rendering region.
+  /// \param[in] num_threads
+  ///   The number of threads, including the calling thread. If this is not
+  ///   positive, the number of hardware threads is used.
+  /// The datasets are prepared for concurrent reads, and the renderers are
+  /// cloned for each thread, so this must be called from the thread that owns
+  /// the renderer styles. If any renderer cannot be cloned, or only one
+  /// thread is used, the plot is rendered serially. The device contexts of the
+  /// tiles are also created on the calling thread, so the worker threads only
+  /// draw. Each tile is rendered with a border, so text and markers that
+  /// cross a tile edge are drawn in both tiles. The statistics of the plot
+  /// renderers are not updated, and text labels are decluttered within each
+  /// tile.
+  void RenderParallel(wxDC& dc, wxRect rc, const int& num_threads) const;
+
+  /// \brief Renders the plot into an image.
+  /// \param[in] width
+  ///   The image width.
+  /// \param[in] height
+  ///   The image height.
+  /// \return The rendered image. This is invalid if the size is not positive
+  ///   or a graphics context could not be created.
+  /// This does not require a window or event loop. The device context copies
+  /// the stock styles, and the renderers draw with their shared styles, so
+  /// this must be called from the thread that owns the renderer styles. Use
+  /// RenderToImages() to render several plots in parallel.
+  wxImage RenderToImage(const int& width, const int& height) const;
+
+  /// \brief Renders several plots into images with several threads.
+  /// \param[in] plots
+  ///   The plots.
+  /// \param[in] width
+  ///   The image width.
+  /// \param[in] height
+  ///   The image height.
+  /// \param[in] num_threads
+  ///   The number of threads, including the calling thread. If this is not
+  ///   positive, the number of hardware threads is used.
+  /// \return The rendered images, in plot order. An image is invalid if the
+  ///   size is not positive or a graphics context could not be created.
+  /// This does not require a window or event loop. Each plot is fitted and
+  /// cloned, and its device context is created, on the calling thread, so the
+  /// worker threads only draw with styles that are not shared. This must be
+  /// called from the thread that owns the renderer styles. Plots with a
+  /// renderer that cannot be cloned are rendered on the calling thread.
+  static std::vector<wxImage> RenderToImages(
+      const std::vector<const Plot2d*>& plots, const int& width,
+      const int& height, const int& num_threads);
+
+  /// \brief Renders the plot renderers with a fixed transform.
+  /// \param[in] dc
+  ///   The device context.
+  /// \param[in] rc
+  ///   The rectangle of the rendering region.
+  /// \param[in] transform
+  ///   The data to graphics transform.
+  /// \param[in] is_cancelled
+  ///   An optional indicator that is checked between renderers. The render
+  ///   stops early if it is set.
+  /// \return If all of the renderers were drawn.
+  /// This does not clear the background or fit the plot, and does not modify
+  /// any plot state. This allows it to run on a worker thread while the plot
+  /// transform is modified, as long as the renderers and datasets are not.
+  bool RenderTransformed(wxDC& dc, const wxRect& rc,
+                         const Plot2dTransform& transform,
+                         const std::atomic<bool>* is_cancelled) const;
+
   /// \brief Shifts the plot.
   /// \param[in] x
   ///   The amount (in graphics units) to shift the x axis.
@@ -136,6 +367,21 @@ class Plot2d {
   /// the offset.
   void Shift(const int& x, const int& y);
 
+  /// \brief Gets the renderer statistics.
+  /// \return The statistics from the last render of each renderer, in draw
+  ///   order.
+  std::vector<Renderer2dStatistics> Statistics() const;
+
+  /// \brief Gets the data to graphics transform.
+  /// \return The data to graphics transform.
+  Plot2dTransform Transform() const;
+
+  /// \brief Gets a version that changes whenever the rendered data changes.
+  /// \return The data version.
+  /// The version increases when renderers are added or cleared, or when any
+  /// dataset is modified. It does not track changes to renderer styles.
+  uint64_t VersionData() const;
+
   /// \brief Zooms the plot.
   /// \param[in] factor
   ///   The zoom factor, which is used to adjust the current plot scale.
@@ -217,10 +463,13 @@ class Plot2d {
   ///   The height/width of the graphics rectangle.
   /// \param[in] is_vertical
   ///   An indicator that adjusts the axis to create.
+  /// \param[in] transform
+  ///   The data to graphics transform.
   /// \return A plot axis (in data coordinates) of the area being rendered.
   ///   These axes are needed by the renderers to draw onto the graphics rect.
-  PlotAxis Axis(const int& position, const int& range,
-                const bool& is_vertical) const;
+  static PlotAxis Axis(const int& position, const int& range,
+                       const bool& is_vertical,
+                       const Plot2dTransform& transform);
 
   /// \brief Does a zoom.
   /// \param[in] factor
@@ -229,6 +478,12 @@ class Plot2d {
   ///   The point (in graphics units) to zoom to.
   void DoZoom(const float& factor, const wxPoint& point) const;
 
+  /// \brief Gets if the data limits are updated.
+  /// \return If the data limits are updated.
+  /// The limits are outdated if the renderers have changed, or if any dataset
+  /// version has changed since the limits were last updated.
+  bool IsUpdatedDataLimits() const;
+
   /// \brief Updates the plot offset and scale to encapsulate the plot data.
   /// \param[in] rc
   ///   The graphics rectangle.
@@ -283,6 +538,25 @@ class Plot2d {
   ///   scaling.
   float scale_y_;
 
+  /// \var is_updated_version_data_
+  ///   An indicator that tells if the data version is updated with the current
+  ///   renderers.
+  mutable bool is_updated_version_data_;
+
+  /// \var version_data_
+  ///   The data version.
+  mutable uint64_t version_data_;
+
+  /// \var versions_data_
+  ///   The dataset versions when the data version was last updated. These are
+  ///   stored in the same order as the renderers.
+  mutable std::vector<uint64_t> versions_data_;
+
+  /// \var versions_datasets_
+  ///   The dataset versions when the data limits were last updated. These are
+  ///   stored in the same order as the renderers.
+  mutable std::vector<uint64_t> versions_datasets_;
+
   /// \var zoom_factor_fitted_
   ///   The zoom factor to apply after the plot is fitted. Setting this to 1
   ///   will not modify the scale or offset.
@@ -4,14 +4,115 @@
 #ifndef APPCOMMON_GRAPHICS_PLOT_PANE_2D_H_
 #define APPCOMMON_GRAPHICS_PLOT_PANE_2D_H_
 
+#include <chrono>  // NOLINT
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
 #include "wx/wx.h"
 
 #include "appcommon/graphics/line_data_set_2d.h"
 #include "appcommon/graphics/plot_2d.h"
+#include "appcommon/graphics/plot_render_worker_2d.h"
+#include "appcommon/graphics/plot_tile_cache_2d.h"
+
+/// \par OVERVIEW
+///
+/// This struct contains the render diagnostics of a plot pane.
+struct PlotPane2dDiagnostics {
+  /// \var duration_frame
+  ///   The time to render the pane for the last paint, in milliseconds.
+  double duration_frame;
+
+  /// \var renderers
+  ///   The statistics of each renderer, from the last time the plot was
+  ///   rendered. This may be older than the last paint if it was drawn from a
+  ///   cached bitmap or asynchronous frame.
+  std::vector<Renderer2dStatistics> renderers;
+};
 
 /// \par OVERVIEW
 ///
 /// This class is an abstract wxAUI pane used for 2d plotting.
+///
+/// \par CACHING
+///
+/// The plot can optionally be rendered into a cached bitmap that is reused
+/// between paints. When the plot is panned, the cached bitmap is shifted by
+/// the pixel offset and only the newly exposed strips are rendered. Each strip
+/// is rendered with a border, so text and markers that cross into it are
+/// drawn, but text labels are decluttered within each strip. A full render is
+/// done when the size, scale, background or data version changes.
+///
+/// Renderer styles and dataset assignments are not tracked, so Refresh()
+/// invalidates the cached bitmap and tiles. The repaints that are scheduled
+/// for mouse zooms and pans keep them. InvalidateCache() can also be called
+/// to force a full render without a refresh.
+///
+/// \par TILING
+///
+/// The plot can instead be rendered through a tile cache, which composites
+/// fixed size tiles that are rendered on demand for each quantized zoom level
+/// and kept within a memory budget. Revisiting an area at a similar zoom is a
+/// blit, and the cost of a render is bounded by the number of visible tiles.
+/// This is intended for plots that are much larger than the window, and takes
+/// precedence over caching.
+///
+/// \par ASYNCHRONOUS RENDERING
+///
+/// The plot can instead be rendered on a worker thread. The paint handler
+/// requests a frame whenever the plot transform or data changes, and draws the
+/// latest completed frame mapped onto the current transform, so pans and
+/// zooms are previewed until the new frame arrives. A newer request cancels
+/// the in-flight frame. This takes precedence over tiling and caching.
+///
+/// Each request renders clones of the plot renderers, so the renderers and
+/// their styles can be modified at any time. The clones still read the
+/// datasets, so while enabled the datasets must only be modified between
+/// BeginUpdate() and EndUpdate(). BeginUpdate() cancels the in-flight frame,
+/// and no frame is requested until the update ends, so the worker never reads
+/// a dataset that is being modified. CancelRender() must also be called before
+/// a derived class destroys datasets that the plot references. The datasets
+/// are prepared before each request, so the plot can be picked while a frame
+/// is rendered. If a renderer does not support cloning, the plot is rendered
+/// on the UI thread instead.
+///
+/// \par PARALLEL RENDERING
+///
+/// Full renders of the plot, both direct and into the cached bitmap, can be
+/// split into tiles that are rendered on several threads. See
+/// Plot2d::RenderParallel(). The exposed strips of a shifted cached bitmap
+/// are small, so they are still rendered on the UI thread.
+///
+/// \par FRAME SCHEDULING
+///
+/// Mouse zooms and pans update the plot transform immediately, but the
+/// repaint is scheduled instead of being requested on every event. Only one
+/// repaint is pending at a time, and repaints are spaced at least one frame
+/// budget apart, or the duration of the last paint if that is longer. Any
+/// number of zoom and pan events between repaints are coalesced into a single
+/// render, so a heavy plot cannot fall behind the input events.
+///
+/// \par OVERLAY
+///
+/// Each paint renders the plot, along with RenderBefore() and RenderAfter(),
+/// into a base frame that is kept between paints. Content that follows the
+/// mouse, such as crosshairs, selection rectangles, and hover highlights,
+/// should instead be drawn by RenderOverlay(), which draws over the base frame
+/// on every paint. Calling RefreshOverlay() with the old and new bounds of the
+/// overlay repaints only those rectangles from the base frame, without
+/// rendering the plot.
+///
+/// Any other Refresh() invalidates the base frame, so the plot is rendered
+/// again on the next paint. The base frame is also rendered again when the
+/// pane is resized.
+///
+/// \par DIAGNOSTICS
+///
+/// The pane can be instrumented to measure the frame time and collect the
+/// renderer statistics on every paint. These are available through
+/// diagnostics() so they can be logged, and are drawn as an overlay after
+/// RenderAfter(). Nothing is measured while disabled.
 class PlotPane2d : public wxPanel {
  public:
   /// \brief Constructor.
@@ -22,6 +123,44 @@ class PlotPane2d : public wxPanel {
   /// \brief Destructor.
   ~PlotPane2d();
 
+  /// \brief Begins modifying the plot datasets.
+  /// Any asynchronous render is cancelled, and new frames are not requested
+  /// until EndUpdate() is called, so the datasets can be modified safely.
+  /// Calls can be nested, and each must be paired with a call to EndUpdate().
+  void BeginUpdate();
+
+  /// \brief Cancels any asynchronous render.
+  /// This blocks until the worker thread is idle. The next paint requests a
+  /// new frame.
+  void CancelRender();
+
+  /// \brief Ends modifying the plot datasets.
+  /// When the outermost update ends, the pane is refreshed so the modified
+  /// datasets are drawn.
+  void EndUpdate();
+
+  /// \brief Invalidates the cached plot bitmap and tiles.
+  /// This forces a full render on the next paint.
+  void InvalidateCache();
+
+  /// \brief Refreshes the pane, and invalidates the base frame and caches.
+  /// \param[in] erase_background
+  ///   An indicator that determines if the background is erased.
+  /// \param[in] rect
+  ///   The rectangle to refresh. The entire pane is refreshed if this is null.
+  /// The plot is fully rendered again on the next paint, even if only part of
+  /// the pane is refreshed, so any renderer or dataset changes are drawn.
+  void Refresh(bool erase_background = true,
+               const wxRect* rect = nullptr) override;
+
+  /// \brief Refreshes the overlay, reusing the base frame.
+  /// \param[in] rect
+  ///   The rectangle that the overlay has changed within. This should cover
+  ///   both the previous and the new overlay bounds.
+  /// The next paint only copies the rectangle from the base frame and draws
+  /// the overlay, and the plot is not rendered.
+  void RefreshOverlay(const wxRect& rect);
+
   /// \brief Renders the plot within the pane.
   /// \param[in] dc
   ///   The device context.
@@ -31,6 +170,39 @@ class PlotPane2d : public wxPanel {
   /// \return The background brush.
   wxBrush background() const;
 
+  /// \brief Gets the frame budget.
+  /// \return The minimum time between scheduled repaints, in milliseconds.
+  int budget_frame() const;
+
+  /// \brief Gets the tile memory budget.
+  /// \return The maximum memory of the cached tiles, in bytes.
+  std::size_t budget_tiles() const;
+
+  /// \brief Gets the render diagnostics.
+  /// \return The render diagnostics from the last paint. This is only updated
+  ///   while the pane is instrumented.
+  const PlotPane2dDiagnostics& diagnostics() const;
+
+  /// \brief Gets if the plot is rendered on a worker thread.
+  /// \return If the plot is rendered on a worker thread.
+  bool is_async() const;
+
+  /// \brief Gets if the plot is rendered through a cached bitmap.
+  /// \return If the plot is rendered through a cached bitmap.
+  bool is_cached() const;
+
+  /// \brief Gets if the render diagnostics are measured and shown.
+  /// \return If the render diagnostics are measured and shown.
+  bool is_instrumented() const;
+
+  /// \brief Gets if the plot is rendered through cached tiles.
+  /// \return If the plot is rendered through cached tiles.
+  bool is_tiled() const;
+
+  /// \brief Gets the number of render threads.
+  /// \return The number of threads used for full renders.
+  int num_threads() const;
+
   /// \brief Gets the plot.
   /// \return The plot
   const Plot2d* plot() const;
@@ -40,6 +212,47 @@ class PlotPane2d : public wxPanel {
   ///   The background brush.
   void set_background(const wxBrush& brush);
 
+  /// \brief Sets the frame budget.
+  /// \param[in] budget_frame
+  ///   The minimum time between scheduled repaints, in milliseconds. A value
+  ///   of zero repaints as soon as the window system allows.
+  void set_budget_frame(const int& budget_frame);
+
+  /// \brief Sets the tile memory budget.
+  /// \param[in] budget_tiles
+  ///   The maximum memory of the cached tiles, in bytes. Tiles that are
+  ///   visible are kept even if they exceed the budget.
+  void set_budget_tiles(const std::size_t& budget_tiles);
+
+  /// \brief Sets if the plot is rendered on a worker thread.
+  /// \param[in] is_async
+  ///   An indicator that determines if the plot is rendered asynchronously.
+  /// While enabled, the datasets are read by the worker thread, so they must
+  /// only be modified between BeginUpdate() and EndUpdate().
+  void set_is_async(const bool& is_async);
+
+  /// \brief Sets if the plot is rendered through a cached bitmap.
+  /// \param[in] is_cached
+  ///   An indicator that determines if the plot is cached.
+  void set_is_cached(const bool& is_cached);
+
+  /// \brief Sets if the render diagnostics are measured and shown.
+  /// \param[in] is_instrumented
+  ///   An indicator that determines if the render diagnostics are measured
+  ///   and shown.
+  void set_is_instrumented(const bool& is_instrumented);
+
+  /// \brief Sets if the plot is rendered through cached tiles.
+  /// \param[in] is_tiled
+  ///   An indicator that determines if the plot is tiled.
+  void set_is_tiled(const bool& is_tiled);
+
+  /// \brief Sets the number of render threads.
+  /// \param[in] num_threads
+  ///   The number of threads used for full renders. One thread renders
+  ///   serially, and a value that is not positive uses every hardware thread.
+  void set_num_threads(const int& num_threads);
+
  protected:
   /// \brief Handles the erase background event.
   /// \param[in] event
@@ -61,6 +274,21 @@ class PlotPane2d : public wxPanel {
   ///   The event.
   void OnPaint(wxPaintEvent& event);
 
+  /// \brief Handles the asynchronous frame completion event.
+  /// \param[in] event
+  ///   The event.
+  void OnThreadFrame(wxThreadEvent& event);
+
+  /// \brief Handles the frame timer event.
+  /// \param[in] event
+  ///   The event.
+  void OnTimerFrame(wxTimerEvent& event);
+
+  /// \brief Refreshes the pane for a zoom, pan, or asynchronous frame.
+  /// This invalidates the base frame, but keeps the cached bitmap and tiles,
+  /// as these do not change what the renderers draw.
+  void RefreshFrame();
+
   /// \brief Renders content after (on top of) the plot.
   /// \param[in] dc
   ///   The device context.
@@ -73,26 +301,204 @@ class PlotPane2d : public wxPanel {
   /// This method is empty but can optionally be overridden.
   virtual void RenderBefore(wxDC& dc);
 
+  /// \brief Renders content over the cached base frame.
+  /// \param[in] dc
+  ///   The device context. This is clipped to the refreshed rectangle.
+  /// This method is empty but can optionally be overridden. It is called on
+  /// every paint, so it should be fast and should not render the plot.
+  virtual void RenderOverlay(wxDC& dc);
+
+  /// \brief Renders the diagnostics overlay.
+  /// \param[in] dc
+  ///   The device context.
+  void RenderDiagnostics(wxDC& dc);
+
+  /// \brief Renders the latest asynchronous frame and requests a new frame
+  ///   if needed.
+  /// \param[in] dc
+  ///   The device context.
+  /// \param[in] rc
+  ///   The rectangle of the rendering region.
+  void RenderAsync(wxDC& dc, const wxRect& rc);
+
+  /// \brief Schedules a repaint.
+  /// The repaint is requested immediately if the frame budget has elapsed
+  /// since the last paint, or else it is requested by the frame timer. This
+  /// does nothing if a repaint is already pending.
+  void ScheduleFrame();
+
+  /// \brief Updates the cached plot bitmap.
+  /// \param[in] rc
+  ///   The rectangle of the rendering region.
+  void UpdateCache(const wxRect& rc);
+
   /// \brief Updates the plot datasets.
+  /// If the pane renders asynchronously, this must be called between
+  /// BeginUpdate() and EndUpdate().
   virtual void UpdatePlotDatasets() = 0;
 
   /// \brief Updates the plot renderers.
   virtual void UpdatePlotRenderers() = 0;
 
+  /// \var bitmap_base_
+  ///   The base frame, which contains the rendered plot without the overlay.
+  wxBitmap bitmap_base_;
+
   /// \var bitmap_buffer_
   ///   The bitmap that is used as a device context buffer. Keeping this cached
   ///   helps speed up redraws.
   wxBitmap bitmap_buffer_;
 
+  /// \var bitmap_cache_
+  ///   The bitmap that the plot is rendered into when caching.
+  wxBitmap bitmap_cache_;
+
+  /// \var bitmap_frame_
+  ///   The latest completed asynchronous frame.
+  wxBitmap bitmap_frame_;
+
+  /// \var budget_frame_
+  ///   The minimum time between scheduled repaints, in milliseconds.
+  int budget_frame_;
+
+  /// \var colour_cache_
+  ///   The background colour of the cached plot bitmap.
+  wxColour colour_cache_;
+
+  /// \var colour_request_
+  ///   The background colour of the latest asynchronous request.
+  wxColour colour_request_;
+
   /// \var coord_mouse_
   ///   The mouse coordinate. This is only kept up-to-date when the mouse is
   ///   being dragged.
   wxPoint coord_mouse_;
 
+  /// \var count_update_
+  ///   The number of dataset updates that have begun and not ended.
+  int count_update_;
+
+  /// \var diagnostics_
+  ///   The render diagnostics from the last instrumented paint.
+  PlotPane2dDiagnostics diagnostics_;
+
+  /// \var duration_paint_
+  ///   The duration of the last paint, in milliseconds.
+  double duration_paint_;
+
+  /// \var id_event_frame_
+  ///   The id of the thread event that the worker queues when an asynchronous
+  ///   frame completes.
+  int id_event_frame_;
+
+  /// \var id_frame_
+  ///   The id of the latest completed asynchronous frame.
+  uint64_t id_frame_;
+
+  /// \var is_async_
+  ///   An indicator that determines if the plot is rendered on a worker
+  ///   thread.
+  bool is_async_;
+
+  /// \var is_cached_
+  ///   An indicator that determines if the plot is rendered through a cached
+  ///   bitmap.
+  bool is_cached_;
+
+  /// \var is_instrumented_
+  ///   An indicator that determines if the render diagnostics are measured
+  ///   and shown.
+  bool is_instrumented_;
+
+  /// \var is_requested_
+  ///   An indicator that tells if an asynchronous frame has been requested
+  ///   with the current request members.
+  bool is_requested_;
+
+  /// \var is_scheduled_
+  ///   An indicator that tells if a repaint has been requested and has not
+  ///   been painted yet.
+  bool is_scheduled_;
+
+  /// \var is_shifted_cache_
+  ///   An indicator that tells if the cached plot bitmap has been shifted since
+  ///   it was last fully rendered.
+  bool is_shifted_cache_;
+
+  /// \var is_tiled_
+  ///   An indicator that determines if the plot is rendered through cached
+  ///   tiles.
+  bool is_tiled_;
+
+  /// \var is_updated_base_
+  ///   An indicator that tells if the base frame is updated.
+  bool is_updated_base_;
+
+  /// \var is_updated_cache_
+  ///   An indicator that tells if the cached plot bitmap is updated.
+  bool is_updated_cache_;
+
+  /// \var num_threads_
+  ///   The number of threads used for full renders.
+  int num_threads_;
+
+  /// \var offset_cache_
+  ///   The plot offset of the cached plot bitmap.
+  Point2d<float> offset_cache_;
+
   /// \var plot_
   ///   The plot.
   Plot2d plot_;
 
+  /// \var scale_cache_
+  ///   The plot scale of the cached plot bitmap.
+  float scale_cache_;
+
+  /// \var scale_x_cache_
+  ///   The plot x scale of the cached plot bitmap.
+  float scale_x_cache_;
+
+  /// \var scale_y_cache_
+  ///   The plot y scale of the cached plot bitmap.
+  float scale_y_cache_;
+
+  /// \var version_cache_
+  ///   The plot data version of the cached plot bitmap.
+  uint64_t version_cache_;
+
+  /// \var size_request_
+  ///   The size of the latest asynchronous request.
+  wxSize size_request_;
+
+  /// \var tiles_
+  ///   The tile cache.
+  PlotTileCache2d tiles_;
+
+  /// \var time_paint_
+  ///   The time when the last paint started.
+  std::chrono::steady_clock::time_point time_paint_;
+
+  /// \var timer_frame_
+  ///   The timer that requests a scheduled repaint.
+  wxTimer timer_frame_;
+
+  /// \var transform_frame_
+  ///   The plot transform of the latest completed asynchronous frame.
+  Plot2dTransform transform_frame_;
+
+  /// \var transform_request_
+  ///   The plot transform of the latest asynchronous request.
+  Plot2dTransform transform_request_;
+
+  /// \var version_request_
+  ///   The plot data version of the latest asynchronous request.
+  uint64_t version_request_;
+
+  /// \var worker_
+  ///   The worker that renders asynchronous frames. This is only allocated
+  ///   while asynchronous rendering is enabled.
+  PlotRenderWorker2d* worker_;
+
   DECLARE_EVENT_TABLE()
 };
 
@@ -0,0 +1,176 @@
+// This is free and unencumbered software released into the public domain.
+// For more information, please refer to <http://unlicense.org/>
+
+#ifndef APPCOMMON_GRAPHICS_PLOT_RENDER_WORKER_2D_H_
+#define APPCOMMON_GRAPHICS_PLOT_RENDER_WORKER_2D_H_
+
+#include <atomic>  // NOLINT
+#include <condition_variable>  // NOLINT
+#include <cstdint>
+#include <mutex>  // NOLINT
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "wx/wx.h"
+
+#include "appcommon/graphics/plot_2d.h"
+
+/// \par OVERVIEW
+///
+/// This class renders a plot into an image on a worker thread.
+///
+/// \par REQUESTS
+///
+/// Only the latest request is kept. A new request replaces any pending
+/// request and cancels the frame that is being rendered, which stops at the
+/// next renderer boundary. This keeps the worker from falling behind when
+/// requests arrive faster than frames can be rendered.
+///
+/// \par FRAMES
+///
+/// When a frame completes, it replaces the latest frame and a thread event is
+/// queued to the event handler, which is processed on the UI thread. The
+/// latest frame can then be copied out along with the transform it was
+/// rendered with.
+///
+/// \par THREAD SAFETY
+///
+/// wxWidgets reference counts are not thread safe, so the worker does not
+/// touch any object that the UI thread can also reference. Each request
+/// clones the plot renderers and their styles, and creates the device context
+/// with new styles, all on the calling thread. The worker only draws with the
+/// clones and device context, and deletes them once the frame is done.
+///
+/// The worker still reads the datasets while rendering. Each request prepares
+/// the datasets first, so the calling thread can keep reading them, such as
+/// with Plot2d::Pick(). The datasets must not be modified until Cancel() has
+/// returned. The plot renderers, styles, and transform can be modified at any
+/// time, as they are copied into each request.
+class PlotRenderWorker2d {
+ public:
+  /// \brief Constructor.
+  /// \param[in] handler
+  ///   The event handler that is notified when a frame completes.
+  /// \param[in] id_event
+  ///   The id of the thread event that is queued when a frame completes.
+  PlotRenderWorker2d(wxEvtHandler* handler, const int& id_event);
+
+  /// \brief Destructor.
+  /// This cancels any render and stops the worker thread.
+  ~PlotRenderWorker2d();
+
+  /// \brief Cancels the pending and in-flight frames.
+  /// This blocks until the worker thread is idle.
+  void Cancel();
+
+  /// \brief Gets the latest completed frame.
+  /// \param[in,out] id
+  ///   The id of the frame that the caller already has. This is updated to
+  ///   the id of the copied frame.
+  /// \param[out] image
+  ///   The frame image.
+  /// \param[out] transform
+  ///   The transform the frame was rendered with.
+  /// \return If a newer frame was copied.
+  bool Frame(uint64_t& id, wxImage& image, Plot2dTransform& transform) const;
+
+  /// \brief Requests a frame.
+  /// \param[in] plot
+  ///   The plot, which is cloned.
+  /// \param[in] size
+  ///   The frame size.
+  /// \param[in] transform
+  ///   The data to graphics transform.
+  /// \param[in] background
+  ///   The background colour.
+  /// \return If the frame was requested. This fails if the size is not
+  ///   positive, a renderer does not support cloning, or a graphics context
+  ///   could not be created.
+  /// This must be called from the thread that owns the renderer styles.
+  bool Request(const Plot2d* plot, const wxSize& size,
+               const Plot2dTransform& transform, const wxColour& background);
+
+  /// \brief Gets the renderer statistics of the latest completed frame.
+  /// \return The renderer statistics of the latest completed frame.
+  std::vector<Renderer2dStatistics> Statistics() const;
+
+ private:
+  /// \brief Deletes the pending request.
+  /// This must be called with the mutex locked, from the thread that creates
+  /// the requests.
+  void ClearRequest();
+
+  /// \brief Runs the worker thread loop.
+  void Run();
+
+  /// \var condition_
+  ///   The condition that signals requests, stops, and idle transitions.
+  std::condition_variable condition_;
+
+  /// \var dc_request_
+  ///   The device context of the pending request, which draws into the
+  ///   request image.
+  wxDC* dc_request_;
+
+  /// \var handler_
+  ///   The event handler that is notified when a frame completes.
+  wxEvtHandler* handler_;
+
+  /// \var id_event_
+  ///   The id of the thread event that is queued when a frame completes.
+  int id_event_;
+
+  /// \var id_frame_
+  ///   The id of the latest completed frame.
+  uint64_t id_frame_;
+
+  /// \var image_frame_
+  ///   The latest completed frame.
+  wxImage image_frame_;
+
+  /// \var image_request_
+  ///   The image of the pending request.
+  wxImage* image_request_;
+
+  /// \var is_busy_
+  ///   An indicator that tells if the worker is rendering.
+  bool is_busy_;
+
+  /// \var is_cancelled_
+  ///   An indicator that cancels the frame being rendered.
+  std::atomic<bool> is_cancelled_;
+
+  /// \var is_pending_
+  ///   An indicator that tells if a request is waiting to be rendered.
+  bool is_pending_;
+
+  /// \var is_stopped_
+  ///   An indicator that stops the worker thread.
+  bool is_stopped_;
+
+  /// \var mutex_
+  ///   The mutex that guards the request and frame members.
+  mutable std::mutex mutex_;
+
+  /// \var plot_request_
+  ///   The plot clone of the pending request.
+  Plot2d* plot_request_;
+
+  /// \var statistics_frame_
+  ///   The renderer statistics of the latest completed frame.
+  std::vector<Renderer2dStatistics> statistics_frame_;
+
+  /// \var thread_
+  ///   The worker thread.
+  std::thread thread_;
+
+  /// \var transform_frame_
+  ///   The transform of the latest completed frame.
+  Plot2dTransform transform_frame_;
+
+  /// \var transform_request_
+  ///   The transform of the pending request.
+  Plot2dTransform transform_request_;
+};
+
+#endif  // APPCOMMON_GRAPHICS_PLOT_RENDER_WORKER_2D_H_
@@ -0,0 +1,183 @@
+// This is free and unencumbered software released into the public domain.
+// For more information, please refer to <http://unlicense.org/>
+
+#ifndef APPCOMMON_GRAPHICS_PLOT_TILE_CACHE_2D_H_
+#define APPCOMMON_GRAPHICS_PLOT_TILE_CACHE_2D_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <map>
+
+#include "wx/wx.h"
+
+#include "appcommon/graphics/plot_2d.h"
+
+/// \par OVERVIEW
+///
+/// This struct identifies a plot tile within the tile grid.
+struct PlotTileKey2d {
+  /// \brief Compares the keys, ordering by level, row, and then column.
+  /// \param[in] other
+  ///   The other key.
+  /// \return If this key is ordered before the other key.
+  bool operator<(const PlotTileKey2d& other) const;
+
+  /// \var column
+  ///   The tile column. Column zero starts at the data x origin.
+  int64_t column;
+
+  /// \var level
+  ///   The quantized zoom level.
+  int level;
+
+  /// \var row
+  ///   The tile row. Row zero starts at the data y origin, and rows increase
+  ///   downward.
+  int64_t row;
+};
+
+/// \par OVERVIEW
+///
+/// This struct is a rendered plot tile.
+struct PlotTile2d {
+  /// \var bitmap
+  ///   The rendered tile.
+  wxBitmap bitmap;
+
+  /// \var key
+  ///   The tile key.
+  PlotTileKey2d key;
+};
+
+/// \par OVERVIEW
+///
+/// This class renders a plot by compositing cached, fixed size tiles.
+///
+/// \par LEVELS
+///
+/// The plot scale is quantized into zoom levels, with several levels per
+/// doubling of the scale. Each level has its own grid of square tiles that is
+/// anchored at the data origin, so a tile covers the same data region every
+/// time it is needed. Tiles are rendered at the level scale and stretched to
+/// the plot scale when compositing, which is at most a few percent.
+///
+/// \par RENDERING
+///
+/// Only the tiles that are visible and not cached are rendered, so a pan or
+/// zoom that revisits an area is a blit, and the worst case cost of a render
+/// is bounded by the number of visible tiles. Each tile renders every plot
+/// renderer, so datasets should be indexed to cull the elements outside of
+/// the tile. Elements that straddle a tile edge are drawn in each tile they
+/// overlap. Text and markers are culled by their anchor point, so each tile is
+/// rendered with a border that is then discarded. Labels that are anchored in
+/// a neighboring tile are still drawn across the edge, unless they extend past
+/// the border.
+///
+/// The tile axes are solved in doubles from the tile indexes, instead of from
+/// the float plot offset, so the tile edges line up for long datasets.
+///
+/// \par MEMORY BUDGET
+///
+/// The tiles are kept in least recently used order. When the tile memory
+/// exceeds the budget, the least recently used tiles are released, except for
+/// tiles that are currently visible.
+///
+/// \par INVALIDATION
+///
+/// All tiles are released when the plot data version, background, or axis
+/// scale factors change. Renderer styles are not tracked, so Clear() should
+/// be called after modifying a renderer that is already in the plot.
+class PlotTileCache2d {
+ public:
+  /// \brief Constructor.
+  PlotTileCache2d();
+
+  /// \brief Destructor.
+  ~PlotTileCache2d();
+
+  /// \brief Releases all of the tiles.
+  void Clear();
+
+  /// \brief Renders the plot.
+  /// \param[in] plot
+  ///   The plot. This is fitted to the rect if fitting is enabled.
+  /// \param[in] dc
+  ///   The device context.
+  /// \param[in] rc
+  ///   The rectangle of the rendering region.
+  void Render(const Plot2d& plot, wxDC& dc, const wxRect& rc);
+
+  /// \brief Gets the number of cached tiles.
+  /// \return The number of cached tiles.
+  std::size_t Size() const;
+
+  /// \brief Gets the memory budget.
+  /// \return The maximum memory of the cached tiles, in bytes.
+  std::size_t budget_memory() const;
+
+  /// \brief Sets the memory budget.
+  /// \param[in] budget_memory
+  ///   The maximum memory of the cached tiles, in bytes.
+  void set_budget_memory(const std::size_t& budget_memory);
+
+ private:
+  /// \brief Releases the least recently used tiles until the memory budget is
+  ///   met.
+  /// \param[in] num_visible
+  ///   The number of most recently used tiles that are visible, and are kept
+  ///   regardless of the budget.
+  void Evict(const std::size_t& num_visible);
+
+  /// \brief Renders a tile.
+  /// \param[in] plot
+  ///   The plot.
+  /// \param[in] key
+  ///   The tile key.
+  /// \param[in] scale_level
+  ///   The plot scale of the tile level.
+  /// \return The rendered tile.
+  wxBitmap RenderTile(const Plot2d& plot, const PlotTileKey2d& key,
+                      const double& scale_level) const;
+
+  /// \brief Gets a tile, rendering it if it is not cached.
+  /// \param[in] plot
+  ///   The plot.
+  /// \param[in] key
+  ///   The tile key.
+  /// \param[in] scale_level
+  ///   The plot scale of the tile level.
+  /// \return The tile bitmap, which is marked as most recently used.
+  const wxBitmap& Tile(const Plot2d& plot, const PlotTileKey2d& key,
+                       const double& scale_level);
+
+  /// \var budget_memory_
+  ///   The maximum memory of the cached tiles, in bytes.
+  std::size_t budget_memory_;
+
+  /// \var colour_
+  ///   The background colour of the cached tiles.
+  wxColour colour_;
+
+  /// \var index_
+  ///   The cached tiles, indexed by key.
+  std::map<PlotTileKey2d, std::list<PlotTile2d>::iterator> index_;
+
+  /// \var scale_x_
+  ///   The plot x scale of the cached tiles.
+  float scale_x_;
+
+  /// \var scale_y_
+  ///   The plot y scale of the cached tiles.
+  float scale_y_;
+
+  /// \var tiles_
+  ///   The cached tiles, from most to least recently used.
+  std::list<PlotTile2d> tiles_;
+
+  /// \var version_
+  ///   The plot data version of the cached tiles.
+  uint64_t version_;
+};
+
+#endif  // APPCOMMON_GRAPHICS_PLOT_TILE_CACHE_2D_H_
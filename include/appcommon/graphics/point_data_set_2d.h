@@ -4,15 +4,25 @@
 #ifndef APPCOMMON_GRAPHICS_POINT_DATA_SET_2D_H_
 #define APPCOMMON_GRAPHICS_POINT_DATA_SET_2D_H_
 
+#include <cstddef>
 #include <list>
+#include <vector>
 
 #include "models/base/point.h"
 
+#include "appcommon/graphics/arena_2d.h"
 #include "appcommon/graphics/data_set_2d.h"
 
 /// \par OVERVIEW
 ///
 /// This class represents a set of 2D lines.
+///
+/// \par STORAGE
+///
+/// The points are constructed in slabs of an arena that is owned by the
+/// dataset, so adding a point does not need its own heap allocation. Clear()
+/// releases the whole arena at once. Points that are added by pointer are kept
+/// as is, outside of the arena.
 class PointDataSet2d : public DataSet2d {
  public:
   /// \brief Constructor.
@@ -24,9 +34,17 @@ class PointDataSet2d : public DataSet2d {
   /// \brief Adds a point to the dataset.
   /// \param[in] point
   ///   The point.
-  /// This class will take ownership of the pointer.
+  /// This class will take ownership of the pointer, which stays valid until
+  /// the dataset is cleared.
   void Add(const Point2d<float>* point);
 
+  /// \brief Adds a point to the dataset.
+  /// \param[in] point
+  ///   The point.
+  /// The point is constructed in the arena, so no separate allocation is
+  /// needed.
+  void Add(const Point2d<float>& point);
+
   /// \brief Clears all of the stored lines.
   void Clear();
 
@@ -46,21 +64,69 @@ class PointDataSet2d : public DataSet2d {
   /// \return The minimum y value.
   float MinY() const override;
 
+  /// \brief Gets the element nearest to a point.
+  /// \param[in] point
+  ///   The point, in data units.
+  /// \param[in] scale_x
+  ///   The factor that scales x data units to graphics units.
+  /// \param[in] scale_y
+  ///   The factor that scales y data units to graphics units.
+  /// \param[in] radius
+  ///   The maximum distance, in graphics units.
+  /// \param[out] index
+  ///   The point index.
+  /// \param[out] distance
+  ///   The distance to the point, in graphics units.
+  /// \return If a point was found within the radius.
+  bool Nearest(const Point2d<float>& point, const float& scale_x,
+               const float& scale_y, const float& radius,
+               unsigned int& index, float& distance) const override;
+
+  /// \brief Gets the number of points.
+  /// \return The number of points.
+  std::size_t Size() const;
+
   /// \brief Gets the data.
   /// \return The data.
+  /// This list is generated from the element storage when it is out of date.
+  /// Use elements() instead when possible.
   const std::list<const Point2d<float>*>* data() const;
 
+  /// \brief Gets the elements.
+  /// \return The elements, in the order they were added.
+  const std::vector<const Point2d<float>*>* elements() const;
+
  private:
-  /// \brief Updates the cached values.
-  void Update() const;
+  /// \brief Adds an element that is already constructed.
+  /// \param[in] point
+  ///   The point, which is owned by the arena or by the pointer list.
+  void AddElement(const Point2d<float>* point);
+
+  /// \brief Updates the spatial index.
+  /// \return If the index was built.
+  bool UpdateIndex() const override;
+
+  /// \var arena_
+  ///   The arena that owns the point storage.
+  Arena2d<Point2d<float>> arena_;
 
   /// \var data_
+  ///   The element pointers that are generated for data().
+  mutable std::list<const Point2d<float>*> data_;
+
+  /// \var elements_
   ///   The point data.
-  std::list<const Point2d<float>*> data_;
+  std::vector<const Point2d<float>*> elements_;
+
+  /// \var is_updated_data_
+  ///   An indicator that tells if the element pointers generated for data()
+  ///   are updated.
+  mutable bool is_updated_data_;
 
-  /// \var is_updated_
-  ///   An indicator that tells if the cached values have been updated.
-  mutable bool is_updated_;
+  /// \var pointers_
+  ///   The elements that were added by pointer, which are deleted when the
+  ///   dataset is cleared.
+  std::vector<const Point2d<float>*> pointers_;
 };
 
 #endif  // APPCOMMON_GRAPHICS_POINT_DATA_SET_2D_H_
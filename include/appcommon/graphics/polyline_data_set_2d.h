@@ -0,0 +1,151 @@
+// This is free and unencumbered software released into the public domain.
+// For more information, please refer to <http://unlicense.org/>
+
+#ifndef APPCOMMON_GRAPHICS_POLYLINE_DATA_SET_2D_H_
+#define APPCOMMON_GRAPHICS_POLYLINE_DATA_SET_2D_H_
+
+#include <cstddef>
+#include <vector>
+
+#include "models/base/point.h"
+
+#include "appcommon/graphics/data_set_2d.h"
+
+/// \par OVERVIEW
+///
+/// This struct is a read-only view of the contiguous polyline storage.
+///
+/// The vertices of polyline i are stored from offsets[i] up to (but not
+/// including) offsets[i + 1].
+///
+/// The view is invalidated when polylines are added to or cleared from the
+/// dataset.
+struct PolylineDataSpan2d {
+  /// \var offsets
+  ///   The vertex offset of each polyline. This contains size + 1 values.
+  const unsigned int* offsets;
+
+  /// \var size
+  ///   The number of polylines.
+  std::size_t size;
+
+  /// \var x
+  ///   The vertex x values.
+  const float* x;
+
+  /// \var y
+  ///   The vertex y values.
+  const float* y;
+};
+
+/// \par OVERVIEW
+///
+/// This class represents a set of 2D polylines.
+///
+/// \par STORAGE
+///
+/// The vertices of all the polylines are stored in one structure-of-arrays
+/// vertex list, and each polyline is a run of consecutive vertices. Connected
+/// curves such as profiles only store each interior vertex once, instead of
+/// twice like a LineDataSet2d.
+///
+/// \par SPATIAL INDEX
+///
+/// The spatial index stores one bounding box per polyline, so a polyline is
+/// culled only if it is entirely outside of the plot axes.
+class PolylineDataSet2d : public DataSet2d {
+ public:
+  /// \brief Constructor.
+  PolylineDataSet2d();
+
+  /// \brief Destructor.
+  virtual ~PolylineDataSet2d();
+
+  /// \brief Adds a polyline to the dataset.
+  /// \param[in] points
+  ///   The polyline vertices.
+  void Add(const std::vector<Point2d<float>>& points);
+
+  /// \brief Adds a polyline to the dataset.
+  /// \param[in] x
+  ///   The vertex x values.
+  /// \param[in] y
+  ///   The vertex y values.
+  /// \param[in] count
+  ///   The number of vertices.
+  void Add(const float* x, const float* y, const std::size_t& count);
+
+  /// \brief Clears all of the stored polylines.
+  void Clear();
+
+  /// \brief Gets the maximum x value.
+  /// \return The maximum x value.
+  float MaxX() const override;
+
+  /// \brief Gets the maximum y value.
+  /// \return The maximum y value.
+  float MaxY() const override;
+
+  /// \brief Gets the minimum x value.
+  /// \return The minimum x value.
+  float MinX() const override;
+
+  /// \brief Gets the minimum y value.
+  /// \return The minimum y value.
+  float MinY() const override;
+
+  /// \brief Gets the element nearest to a point.
+  /// \param[in] point
+  ///   The point, in data units.
+  /// \param[in] scale_x
+  ///   The factor that scales x data units to graphics units.
+  /// \param[in] scale_y
+  ///   The factor that scales y data units to graphics units.
+  /// \param[in] radius
+  ///   The maximum distance, in graphics units.
+  /// \param[out] index
+  ///   The polyline index.
+  /// \param[out] distance
+  ///   The distance to the polyline, in graphics units.
+  /// \return If a polyline was found within the radius.
+  bool Nearest(const Point2d<float>& point, const float& scale_x,
+               const float& scale_y, const float& radius,
+               unsigned int& index, float& distance) const override;
+
+  /// \brief Reserves storage for vertices.
+  /// \param[in] count
+  ///   The total number of vertices to reserve storage for.
+  void Reserve(const std::size_t& count);
+
+  /// \brief Gets the number of polylines.
+  /// \return The number of polylines.
+  std::size_t Size() const;
+
+  /// \brief Gets the number of vertices.
+  /// \return The number of vertices in all of the polylines.
+  std::size_t SizeVertices() const;
+
+  /// \brief Gets a view of the contiguous polyline storage.
+  /// \return A view of the contiguous polyline storage.
+  PolylineDataSpan2d Span() const;
+
+ private:
+  /// \brief Updates the spatial index.
+  /// \return If the index was built.
+  bool UpdateIndex() const override;
+
+  /// \var offsets_
+  ///   The vertex offset of each polyline, followed by the total number of
+  ///   vertices.
+  std::vector<unsigned int> offsets_;
+
+  /// \var x_
+  ///   The vertex x values.
+  std::vector<float> x_;
+
+  /// \var y_
+  ///   The vertex y values.
+  std::vector<float> y_;
+};
+
+#endif  // APPCOMMON_GRAPHICS_POLYLINE_DATA_SET_2D_H_
@@ -4,14 +4,68 @@
 #ifndef APPCOMMON_GRAPHICS_RENDERER_2D_H_
 #define APPCOMMON_GRAPHICS_RENDERER_2D_H_
 
+#include <cstddef>
+#include <list>
+#include <vector>
+
 #include "wx/wx.h"
 
 #include "appcommon/graphics/data_set_2d.h"
 #include "appcommon/graphics/plot_axis.h"
+#include "appcommon/graphics/svg_writer_2d.h"
+#include "appcommon/graphics/vertex_cache_2d.h"
+
+/// \par OVERVIEW
+///
+/// This struct contains the statistics from the last time a renderer drew.
+struct Renderer2dStatistics {
+  /// \var count_drawn
+  ///   The number of elements that were drawn. Renderers that draw connected
+  ///   curves count the line segments instead.
+  std::size_t count_drawn;
+
+  /// \var count_total
+  ///   The number of elements (or line segments) in the dataset.
+  std::size_t count_total;
+
+  /// \var duration
+  ///   The draw time, in milliseconds.
+  double duration;
+};
 
 /// \par OVERVIEW
 ///
 /// This class is an abstract renderer which must be derived from.
+///
+/// \par VERTEX CACHE
+///
+/// Renderers can cache the graphics coordinates of their dataset, so a pan
+/// only needs to translate the cached coordinates instead of transforming
+/// every element again. The cache is rebuilt when the plot is zoomed, the
+/// dataset version changes, or the view leaves the cached region. The cache
+/// keeps a copy of the coordinates for each renderer, so it is disabled by
+/// default and is enabled with set_is_cached().
+///
+/// \par STATISTICS
+///
+/// Render() times the draw and keeps statistics that can be used to profile
+/// the plot. Derived renderers record the number of elements they draw, and
+/// the difference from the dataset size is the number of culled elements.
+///
+/// \par CLONING
+///
+/// Renderers can be cloned so several threads can draw the same dataset at
+/// once, with each thread using its own clone. A clone references the same
+/// dataset, but has its own vertex cache and statistics, and its own copies
+/// of the pens, brushes, and colours. wxWidgets does not count references
+/// atomically, so the styles cannot be shared between threads.
+///
+/// \par VECTOR EXPORT
+///
+/// Renderers can write their dataset to a vector file instead of a device
+/// context. The export uses the same culling and clipping as a draw, but
+/// bypasses the vertex cache, so the elements are written with the export
+/// region and the cache is left intact for the next draw.
 class Renderer2d {
  public:
   /// \brief Constructor.
@@ -20,6 +74,13 @@ class Renderer2d {
   /// \brief Destructor.
   virtual ~Renderer2d();
 
+  /// \brief Clones the renderer.
+  /// \return A new renderer that draws the same dataset with copies of the
+  ///   same styles. The caller takes ownership of the pointer. This is a null
+  ///   pointer if the renderer does not support cloning.
+  /// The clone must be created on the thread that owns the original styles.
+  virtual Renderer2d* Clone() const;
+
   /// \brief Draws the data onto the device context.
   /// \param[in] dc
   ///   The device context.
@@ -32,6 +93,36 @@ class Renderer2d {
   virtual void Draw(wxDC& dc, wxRect rc, const PlotAxis& axis_horizontal,
                     const PlotAxis& axis_vertical) const = 0;
 
+  /// \brief Writes the data to a vector file.
+  /// \param[in] dc
+  ///   The device context that supplies the background colour and the text
+  ///   font. Nothing is drawn onto it.
+  /// \param[in] writer
+  ///   The vector file writer, which must be open.
+  /// \param[in] rc
+  ///   The region to write to.
+  /// \param[in] axis_horizontal
+  ///   The horizontal plot axis.
+  /// \param[in] axis_vertical
+  ///   The vertical plot axis.
+  /// The base renderer does not support exporting, and writes nothing.
+  virtual void Export(wxDC& dc, SvgWriter2d& writer, wxRect rc,
+                      const PlotAxis& axis_horizontal,
+                      const PlotAxis& axis_vertical) const;
+
+  /// \brief Draws the data onto the device context and updates the
+  ///   statistics.
+  /// \param[in] dc
+  ///   The device context.
+  /// \param[in] rc
+  ///   The dc region to draw onto.
+  /// \param[in] axis_horizontal
+  ///   The horizontal plot axis.
+  /// \param[in] axis_vertical
+  ///   The vertical plot axis.
+  void Render(wxDC& dc, wxRect rc, const PlotAxis& axis_horizontal,
+              const PlotAxis& axis_vertical) const;
+
   /// \brief Gets if the rendered item must contrast the background color.
   /// \return If the rendered item must always contrast the background color.
   bool always_contrast_background() const;
@@ -40,6 +131,10 @@ class Renderer2d {
   /// \return The dataset.
   const DataSet2d* dataset() const;
 
+  /// \brief Gets if the graphics coordinates are cached.
+  /// \return If the graphics coordinates are cached.
+  bool is_cached() const;
+
   /// \brief Sets if the rendered item must contrast the background color.
   /// \param[in] always_contrast_background
   ///   The indicator.
@@ -48,9 +143,36 @@ class Renderer2d {
   /// \brief Sets the dataset.
   /// \param[in] dataset
   ///   The dataset.
-  void set_dataset(const DataSet2d* dataset);
+  /// Typed renderers override this to reject a dataset of the wrong type.
+  virtual void set_dataset(const DataSet2d* dataset);
+
+  /// \brief Sets if the graphics coordinates are cached.
+  /// \param[in] is_cached
+  ///   An indicator that determines if the graphics coordinates are cached.
+  ///   This defaults to false.
+  void set_is_cached(const bool& is_cached);
+
+  /// \brief Gets the statistics.
+  /// \return The statistics from the last render.
+  const Renderer2dStatistics& statistics() const;
 
  protected:
+  /// \brief Copy constructor.
+  /// \param[in] other
+  ///   The renderer to copy.
+  /// The vertex cache, statistics, and style copies are not copied.
+  Renderer2d(const Renderer2d& other);
+
+  /// \brief Gets a brush that contrasts the background, if required.
+  /// \param[in] brush
+  ///   The brush.
+  /// \param[in] background
+  ///   The background colour.
+  /// \return The brush, with an inverted colour if it matches the background
+  ///   and the rendered item must contrast the background.
+  wxBrush BrushContrasted(const wxBrush& brush,
+                          const wxColour& background) const;
+
   /// \brief Clips the points to fit the horizontal axis.
   /// \param[in] axis
   ///   The axis, which contains the bounds/limits.
@@ -85,6 +207,15 @@ class Renderer2d {
                            const float& x_vis, const float& y_vis,
                            float& x, float& y);
 
+  /// \brief Gets a pen that contrasts the background, if required.
+  /// \param[in] pen
+  ///   The pen.
+  /// \param[in] background
+  ///   The background colour.
+  /// \return The pen, with an inverted colour if it matches the background
+  ///   and the rendered item must contrast the background.
+  wxPen PenContrasted(const wxPen& pen, const wxColour& background) const;
+
   /// \brief Translates from data to graphics coordinates.
   /// \param[in] value
   ///   The data value to convert.
@@ -105,6 +236,39 @@ class Renderer2d {
                                 const int& range_graphics,
                                 const bool& is_vertical);
 
+  /// \brief Copies a brush that is owned by this renderer.
+  /// \param[in] brush
+  ///   The brush, which can be null.
+  /// \return The copy, which does not share a reference count with the
+  ///   original brush. This is null if the brush is null.
+  const wxBrush* CopyStyle(const wxBrush* brush);
+
+  /// \brief Copies a colour that is owned by this renderer.
+  /// \param[in] colour
+  ///   The colour, which can be null.
+  /// \return The copy, which does not share a reference count with the
+  ///   original colour. This is null if the colour is null.
+  const wxColour* CopyStyle(const wxColour* colour);
+
+  /// \brief Copies a pen that is owned by this renderer.
+  /// \param[in] pen
+  ///   The pen, which can be null.
+  /// \return The copy, which does not share a reference count with the
+  ///   original pen. This is null if the pen is null.
+  const wxPen* CopyStyle(const wxPen* pen);
+
+  /// \brief Draws line segments onto the device context in batches.
+  /// \param[in] dc
+  ///   The device context.
+  /// \param[in] points
+  ///   The segment points, in graphics coordinates. Each segment is stored as
+  ///   consecutive start and end points.
+  /// If the device context is backed by a graphics context, all segments are
+  /// stroked as a single path. Otherwise, segments that share endpoints are
+  /// joined into polylines and submitted in large chunks. Both avoid a
+  /// separate draw call for every segment.
+  static void DrawSegments(wxDC& dc, const std::vector<wxPoint>& points);
+
   /// \brief Inverts a color.
   /// \param[in] color
   ///   The color to invert.
@@ -116,9 +280,87 @@ class Renderer2d {
   ///   be different than the background color.
   bool always_contrast_background_;
 
+  /// \var brushes_
+  ///   The brushes that are copied by CopyStyle().
+  std::list<wxBrush> brushes_;
+
+  /// \var cache_
+  ///   The cached graphics coordinates.
+  mutable VertexCache2d cache_;
+
+  /// \var colours_
+  ///   The colours that are copied by CopyStyle().
+  std::list<wxColour> colours_;
+
   /// \var dataset_
   ///   The dataset.
   const DataSet2d* dataset_;
+
+  /// \var is_cached_
+  ///   An indicator that determines if the graphics coordinates are cached.
+  bool is_cached_;
+
+  /// \var pens_
+  ///   The pens that are copied by CopyStyle().
+  std::list<wxPen> pens_;
+
+  /// \var statistics_
+  ///   The statistics from the last render. Derived renderers update the
+  ///   element counts when drawing.
+  mutable Renderer2dStatistics statistics_;
+};
+
+/// \par OVERVIEW
+///
+/// This class template is an abstract renderer for a specific dataset type.
+///
+/// \par TYPED DATASET
+///
+/// The dataset type is known at compile time, so derived renderers access the
+/// dataset without a dynamic_cast in every draw, and the compiler can inline
+/// the non-virtual dataset accessors into the draw loops. The dataset type is
+/// checked once when the dataset is set, which keeps the static cast safe.
+///
+/// The renderer is still a Renderer2d, so renderers of different types can be
+/// stored together in a plot.
+template <class T>
+class Renderer2dT : public Renderer2d {
+ public:
+  /// \brief Gets the dataset.
+  /// \return The dataset.
+  const T* dataset() const;
+
+  /// \brief Sets the dataset.
+  /// \param[in] dataset
+  ///   The dataset.
+  /// The dataset is not changed if it is not of the renderer dataset type.
+  void set_dataset(const DataSet2d* dataset) override;
+
+  /// \brief Sets the dataset.
+  /// \param[in] dataset
+  ///   The dataset.
+  void set_dataset(const T* dataset);
 };
 
+template <class T>
+const T* Renderer2dT<T>::dataset() const {
+  return static_cast<const T*>(dataset_);
+}
+
+template <class T>
+void Renderer2dT<T>::set_dataset(const DataSet2d* dataset) {
+  // checks the dataset type
+  // a null dataset is allowed, as it clears the dataset
+  if ((dataset != nullptr) && (dynamic_cast<const T*>(dataset) == nullptr)) {
+    return;
+  }
+
+  Renderer2d::set_dataset(dataset);
+}
+
+template <class T>
+void Renderer2dT<T>::set_dataset(const T* dataset) {
+  Renderer2d::set_dataset(dataset);
+}
+
 #endif  // APPCOMMON_GRAPHICS_RENDERER_2D_H_
@@ -0,0 +1,132 @@
+// This is free and unencumbered software released into the public domain.
+// For more information, please refer to <http://unlicense.org/>
+
+#ifndef APPCOMMON_GRAPHICS_SPATIAL_INDEX_2D_H_
+#define APPCOMMON_GRAPHICS_SPATIAL_INDEX_2D_H_
+
+#include <cstddef>
+#include <vector>
+
+/// \par OVERVIEW
+///
+/// This struct is an axis-aligned bounding box.
+struct BoundingBox2d {
+  /// \var x_max
+  ///   The maximum x value.
+  float x_max;
+
+  /// \var x_min
+  ///   The minimum x value.
+  float x_min;
+
+  /// \var y_max
+  ///   The maximum y value.
+  float y_max;
+
+  /// \var y_min
+  ///   The minimum y value.
+  float y_min;
+};
+
+/// \par OVERVIEW
+///
+/// This class is a uniform grid that indexes the bounding boxes of dataset
+/// elements, so that the elements intersecting a region can be found without
+/// checking every element.
+///
+/// \par GRID
+///
+/// The grid spans the extents of all the boxes, and is sized so that each cell
+/// contains a few elements on average. The cell contents are stored in one
+/// contiguous array, with an offset array marking where each cell starts.
+///
+/// Elements that span many cells are not stored in the grid. They are kept in
+/// a separate list that is checked on every query instead.
+///
+/// \par QUERY
+///
+/// An element that spans several cells is only reported from the first cell
+/// that it shares with the query region. This avoids duplicates without
+/// keeping any state, so a built index can be queried from multiple threads.
+class SpatialIndex2d {
+ public:
+  /// \brief Constructor.
+  SpatialIndex2d();
+
+  /// \brief Destructor.
+  ~SpatialIndex2d();
+
+  /// \brief Builds the index.
+  /// \param[in] boxes
+  ///   The element bounding boxes. The element index is the position in the
+  ///   vector.
+  void Build(const std::vector<BoundingBox2d>& boxes);
+
+  /// \brief Clears the index.
+  void Clear();
+
+  /// \brief Gets the elements that intersect a region.
+  /// \param[in] region
+  ///   The region to search.
+  /// \param[out] indexes
+  ///   The element indexes, sorted in ascending order. Any existing values are
+  ///   cleared.
+  void Query(const BoundingBox2d& region,
+             std::vector<unsigned int>& indexes) const;
+
+  /// \brief Gets the number of indexed elements.
+  /// \return The number of indexed elements.
+  std::size_t Size() const;
+
+ private:
+  /// \brief Gets the column index that contains the x value.
+  /// \param[in] x
+  ///   The x value.
+  /// \return The column index, clamped to the grid.
+  int CellX(const float& x) const;
+
+  /// \brief Gets the row index that contains the y value.
+  /// \param[in] y
+  ///   The y value.
+  /// \return The row index, clamped to the grid.
+  int CellY(const float& y) const;
+
+  /// \var boxes_
+  ///   The element bounding boxes.
+  std::vector<BoundingBox2d> boxes_;
+
+  /// \var cell_offsets_
+  ///   The position in the cell index array where each cell starts. This has
+  ///   one more value than the number of cells.
+  std::vector<unsigned int> cell_offsets_;
+
+  /// \var cell_indexes_
+  ///   The element indexes contained in the cells, stored cell by cell.
+  std::vector<unsigned int> cell_indexes_;
+
+  /// \var extents_
+  ///   The extents of all the bounding boxes.
+  BoundingBox2d extents_;
+
+  /// \var indexes_oversized_
+  ///   The elements that span too many cells to be stored in the grid.
+  std::vector<unsigned int> indexes_oversized_;
+
+  /// \var num_cells_x_
+  ///   The number of grid columns.
+  int num_cells_x_;
+
+  /// \var num_cells_y_
+  ///   The number of grid rows.
+  int num_cells_y_;
+
+  /// \var size_cell_x_
+  ///   The width of a grid cell.
+  float size_cell_x_;
+
+  /// \var size_cell_y_
+  ///   The height of a grid cell.
+  float size_cell_y_;
+};
+
+#endif  // APPCOMMON_GRAPHICS_SPATIAL_INDEX_2D_H_
@@ -0,0 +1,226 @@
+// This is free and unencumbered software released into the public domain.
+// For more information, please refer to <http://unlicense.org/>
+
+#ifndef APPCOMMON_GRAPHICS_STREAM_DATA_SET_2D_H_
+#define APPCOMMON_GRAPHICS_STREAM_DATA_SET_2D_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+#include "appcommon/graphics/data_set_2d.h"
+
+/// \par OVERVIEW
+///
+/// This struct is a candidate extent value within the sliding window.
+struct StreamExtent2d {
+  /// \var sequence
+  ///   The sequence number of the sample.
+  uint64_t sequence;
+
+  /// \var value
+  ///   The value.
+  float value;
+};
+
+/// \par OVERVIEW
+///
+/// This struct is a read-only view of the samples in a stream dataset, from
+/// oldest to newest.
+///
+/// The ring buffer can wrap around, so the samples are split into a first and
+/// second contiguous part. The second part is empty if the buffer has not
+/// wrapped.
+///
+/// The view is invalidated when samples are added to or cleared from the
+/// dataset.
+struct StreamDataSpan2d {
+  /// \var size_first
+  ///   The number of samples in the first part.
+  std::size_t size_first;
+
+  /// \var size_second
+  ///   The number of samples in the second part.
+  std::size_t size_second;
+
+  /// \var x_first
+  ///   The x values of the first part.
+  const float* x_first;
+
+  /// \var x_second
+  ///   The x values of the second part.
+  const float* x_second;
+
+  /// \var y_first
+  ///   The y values of the first part.
+  const float* y_first;
+
+  /// \var y_second
+  ///   The y values of the second part.
+  const float* y_second;
+};
+
+/// \par OVERVIEW
+///
+/// This class represents a live stream of 2D samples, such as telemetry,
+/// which are drawn as a connected curve.
+///
+/// \par RING BUFFER
+///
+/// The samples are stored in a fixed capacity ring buffer. Adding a sample is
+/// O(1), and once the buffer is full the oldest sample is overwritten. Memory
+/// is allocated once when the dataset is constructed, so it stays bounded no
+/// matter how long the stream runs.
+///
+/// \par EXTENTS
+///
+/// The extents of the samples in the buffer are tracked with monotonic
+/// min/max queues. Each queue only keeps the samples that can still become
+/// the extent as older samples are evicted, so the extents are updated in
+/// amortized O(1) time per sample and are always available without scanning
+/// the buffer.
+///
+/// \par SPATIAL INDEX
+///
+/// The data changes with every sample, so the dataset does not support a
+/// spatial index.
+class StreamDataSet2d : public DataSet2d {
+ public:
+  /// \brief Constructor.
+  /// \param[in] capacity
+  ///   The maximum number of samples that are kept.
+  explicit StreamDataSet2d(const std::size_t& capacity);
+
+  /// \brief Destructor.
+  virtual ~StreamDataSet2d();
+
+  /// \brief Adds a sample to the dataset.
+  /// \param[in] x
+  ///   The x value.
+  /// \param[in] y
+  ///   The y value.
+  /// If the dataset is full, the oldest sample is removed.
+  void Add(const float& x, const float& y);
+
+  /// \brief Clears all of the stored samples.
+  void Clear();
+
+  /// \brief Gets the maximum x value.
+  /// \return The maximum x value.
+  float MaxX() const override;
+
+  /// \brief Gets the maximum y value.
+  /// \return The maximum y value.
+  float MaxY() const override;
+
+  /// \brief Gets the minimum x value.
+  /// \return The minimum x value.
+  float MinX() const override;
+
+  /// \brief Gets the minimum y value.
+  /// \return The minimum y value.
+  float MinY() const override;
+
+  /// \brief Gets the element nearest to a point.
+  /// \param[in] point
+  ///   The point, in data units.
+  /// \param[in] scale_x
+  ///   The factor that scales x data units to graphics units.
+  /// \param[in] scale_y
+  ///   The factor that scales y data units to graphics units.
+  /// \param[in] radius
+  ///   The maximum distance, in graphics units.
+  /// \param[out] index
+  ///   The sample index of the nearest segment start, where the oldest
+  ///   sample is zero.
+  /// \param[out] distance
+  ///   The distance to the curve, in graphics units.
+  /// \return If a segment was found within the radius.
+  bool Nearest(const Point2d<float>& point, const float& scale_x,
+               const float& scale_y, const float& radius,
+               unsigned int& index, float& distance) const override;
+
+  /// \brief Gets the number of samples.
+  /// \return The number of samples.
+  std::size_t Size() const;
+
+  /// \brief Gets a view of the samples.
+  /// \return A view of the samples, from oldest to newest.
+  StreamDataSpan2d Span() const;
+
+  /// \brief Gets the capacity.
+  /// \return The maximum number of samples that are kept.
+  std::size_t capacity() const;
+
+ private:
+  /// \brief Adds a value to a maximum queue.
+  /// \param[in] sequence
+  ///   The sample sequence number.
+  /// \param[in] value
+  ///   The value.
+  /// \param[in,out] extents
+  ///   The queue, with values decreasing from front to back.
+  static void PushMax(const uint64_t& sequence, const float& value,
+                      std::deque<StreamExtent2d>& extents);
+
+  /// \brief Adds a value to a minimum queue.
+  /// \param[in] sequence
+  ///   The sample sequence number.
+  /// \param[in] value
+  ///   The value.
+  /// \param[in,out] extents
+  ///   The queue, with values increasing from front to back.
+  static void PushMin(const uint64_t& sequence, const float& value,
+                      std::deque<StreamExtent2d>& extents);
+
+  /// \brief Removes an evicted sample from a queue.
+  /// \param[in] sequence
+  ///   The sequence number of the evicted sample.
+  /// \param[in,out] extents
+  ///   The queue.
+  static void Pop(const uint64_t& sequence,
+                  std::deque<StreamExtent2d>& extents);
+
+  /// \var capacity_
+  ///   The maximum number of samples.
+  std::size_t capacity_;
+
+  /// \var extents_x_max_
+  ///   The monotonic queue of maximum x values.
+  std::deque<StreamExtent2d> extents_x_max_;
+
+  /// \var extents_x_min_
+  ///   The monotonic queue of minimum x values.
+  std::deque<StreamExtent2d> extents_x_min_;
+
+  /// \var extents_y_max_
+  ///   The monotonic queue of maximum y values.
+  std::deque<StreamExtent2d> extents_y_max_;
+
+  /// \var extents_y_min_
+  ///   The monotonic queue of minimum y values.
+  std::deque<StreamExtent2d> extents_y_min_;
+
+  /// \var index_head_
+  ///   The buffer index where the next sample is stored.
+  std::size_t index_head_;
+
+  /// \var sequence_
+  ///   The total number of samples that have been added.
+  uint64_t sequence_;
+
+  /// \var size_
+  ///   The number of samples in the buffer.
+  std::size_t size_;
+
+  /// \var x_
+  ///   The x value buffer.
+  std::vector<float> x_;
+
+  /// \var y_
+  ///   The y value buffer.
+  std::vector<float> y_;
+};
+
+#endif  // APPCOMMON_GRAPHICS_STREAM_DATA_SET_2D_H_
@@ -0,0 +1,90 @@
+// This is free and unencumbered software released into the public domain.
+// For more information, please refer to <http://unlicense.org/>
+
+#ifndef APPCOMMON_GRAPHICS_STREAM_RENDERER_2D_H_
+#define APPCOMMON_GRAPHICS_STREAM_RENDERER_2D_H_
+
+#include <vector>
+
+#include "wx/wx.h"
+
+#include "appcommon/graphics/renderer_2d.h"
+#include "appcommon/graphics/stream_data_set_2d.h"
+
+/// \par OVERVIEW
+///
+/// This class renders a stream dataset onto a plot, connecting the samples
+/// from oldest to newest.
+///
+/// The stream changes with every sample, so the graphics coordinates should
+/// not be cached.
+class StreamRenderer2d : public Renderer2dT<StreamDataSet2d> {
+ public:
+  /// \brief Constructor.
+  StreamRenderer2d();
+
+  /// \brief Clones the renderer.
+  /// \return A new renderer that draws the same dataset with copies of the
+  ///   same styles. The caller takes ownership of the pointer.
+  Renderer2d* Clone() const override;
+
+  /// \brief Draws the data onto the device context.
+  /// \param[in] dc
+  ///   The device context.
+  /// \param[in] rc
+  ///   The dc region to draw onto.
+  /// \param[in] axis_horizontal
+  ///   The horizontal plot axis.
+  /// \param[in] axis_vertical
+  ///   The vertical plot axis.
+  void Draw(wxDC& dc, wxRect rc, const PlotAxis& axis_horizontal,
+            const PlotAxis& axis_vertical) const override;
+
+  /// \brief Writes the data to a vector file.
+  /// \param[in] dc
+  ///   The device context that supplies the background colour.
+  /// \param[in] writer
+  ///   The vector file writer.
+  /// \param[in] rc
+  ///   The region to write to.
+  /// \param[in] axis_horizontal
+  ///   The horizontal plot axis.
+  /// \param[in] axis_vertical
+  ///   The vertical plot axis.
+  void Export(wxDC& dc, SvgWriter2d& writer, wxRect rc,
+              const PlotAxis& axis_horizontal,
+              const PlotAxis& axis_vertical) const override;
+
+  /// \brief Gets the pen.
+  /// \return The pen.
+  const wxPen* pen() const;
+
+  /// \brief Sets the pen.
+  /// \param[in] pen
+  ///   The pen.
+  void set_pen(const wxPen* pen);
+
+ private:
+  /// \brief Transforms the segments between consecutive samples to graphics
+  ///   coordinates.
+  /// \param[in] rc
+  ///   The dc region to draw onto.
+  /// \param[in] axis_horizontal
+  ///   The horizontal plot axis.
+  /// \param[in] axis_vertical
+  ///   The vertical plot axis.
+  /// \param[out] points
+  ///   The visible segments, stored as consecutive start and end points.
+  ///   These are wxPoint for drawing, or wxRealPoint for exporting without
+  ///   rounding.
+  template <typename T>
+  void TransformStream(const wxRect& rc, const PlotAxis& axis_horizontal,
+                       const PlotAxis& axis_vertical,
+                       std::vector<T>& points) const;
+
+  /// \var pen_
+  ///   The pen.
+  const wxPen* pen_;
+};
+
+#endif  // APPCOMMON_GRAPHICS_STREAM_RENDERER_2D_H_
@@ -0,0 +1,165 @@
+// This is free and unencumbered software released into the public domain.
+// For more information, please refer to <http://unlicense.org/>
+
+#ifndef APPCOMMON_GRAPHICS_SVG_WRITER_2D_H_
+#define APPCOMMON_GRAPHICS_SVG_WRITER_2D_H_
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "wx/wx.h"
+
+/// \par OVERVIEW
+///
+/// This class streams a 2D vector drawing to an SVG file.
+///
+/// \par STREAMING
+///
+/// Every element is formatted and written to the file as soon as it is added,
+/// and nothing is kept in memory besides the current style. The memory use
+/// does not depend on the size of the drawing, so very large plots can be
+/// written without building a document tree.
+///
+/// \par STYLE GROUPING
+///
+/// The pen, brush, and font attributes are written once on a group element
+/// instead of on every shape. A new group is only started when the style
+/// changes, so consecutive renderers that share a style also share a group.
+///
+/// \par POLYLINE RUNS
+///
+/// Line segments that share endpoints are joined into runs, and all of the
+/// runs from a single call are written as one path element. The coordinates
+/// within a run are relative to the previous point, which keeps dense curves
+/// compact.
+///
+/// \par PRECISION
+///
+/// Coordinates are written with fractions, rounded to a hundredth of a graphics
+/// unit, so the drawing is not snapped to the pixel grid when it is scaled.
+/// Relative coordinates are solved from the rounded points, so the rounding
+/// does not accumulate along a run.
+class SvgWriter2d {
+ public:
+  /// \brief Constructor.
+  SvgWriter2d();
+
+  /// \brief Destructor. The file is closed if it is still open.
+  ~SvgWriter2d();
+
+  /// \brief Copy constructor. The writer owns its file, so it is not copied.
+  SvgWriter2d(const SvgWriter2d&) = delete;
+
+  /// \brief Assignment operator. The writer owns its file, so it is not
+  ///   assigned.
+  SvgWriter2d& operator=(const SvgWriter2d&) = delete;
+
+  /// \brief Finishes the document and closes the file.
+  /// \return If the file was open and every write succeeded.
+  bool Close();
+
+  /// \brief Gets if the file is open.
+  /// \return If the file is open.
+  bool IsOpen() const;
+
+  /// \brief Creates the file and writes the document header.
+  /// \param[in] filename
+  ///   The file path. An existing file is overwritten.
+  /// \param[in] width
+  ///   The drawing width, in graphics units.
+  /// \param[in] height
+  ///   The drawing height, in graphics units.
+  /// \param[in] background
+  ///   The background colour, which fills the drawing.
+  /// \return If the file was created.
+  bool Open(const std::string& filename, const int& width, const int& height,
+            const wxColour& background);
+
+  /// \brief Sets the style of the shapes that are written next.
+  /// \param[in] pen
+  ///   The pen that outlines the shapes. The shapes are not outlined if this
+  ///   is null or transparent.
+  /// \param[in] brush
+  ///   The brush that fills the shapes. The shapes are not filled if this is
+  ///   null or transparent.
+  void SetStyle(const wxPen* pen, const wxBrush* brush);
+
+  /// \brief Sets the style of the text that is written next.
+  /// \param[in] colour
+  ///   The text colour.
+  /// \param[in] font
+  ///   The text font.
+  void SetStyleText(const wxColour& colour, const wxFont& font);
+
+  /// \brief Writes a circle.
+  /// \param[in] center
+  ///   The center, in graphics units.
+  /// \param[in] radius
+  ///   The radius, in graphics units.
+  void WriteCircle(const wxRealPoint& center, const double& radius);
+
+  /// \brief Writes points.
+  /// \param[in] points
+  ///   The points, in graphics units. Each point is drawn as a one unit line
+  ///   with the current pen.
+  void WritePoints(const std::vector<wxRealPoint>& points);
+
+  /// \brief Writes line segments.
+  /// \param[in] points
+  ///   The segment points, in graphics units. Each segment is stored as
+  ///   consecutive start and end points.
+  void WriteSegments(const std::vector<wxRealPoint>& points);
+
+  /// \brief Writes text.
+  /// \param[in] message
+  ///   The UTF-8 message.
+  /// \param[in] point
+  ///   The upper left corner of the text, in graphics units.
+  /// \param[in] angle
+  ///   The counter-clockwise rotation about the point, in degrees.
+  void WriteText(const std::string& message, const wxRealPoint& point,
+                 const float& angle);
+
+ private:
+  /// \brief Escapes the XML markup characters in a string.
+  /// \param[in] str
+  ///   The string.
+  /// \return The escaped string.
+  static std::string Escape(const std::string& str);
+
+  /// \brief Formats a colour as SVG paint attributes.
+  /// \param[in] name
+  ///   The paint attribute name, such as stroke or fill.
+  /// \param[in] colour
+  ///   The colour.
+  /// \return The attributes, with a leading space.
+  static std::string Paint(const std::string& name, const wxColour& colour);
+
+  /// \brief Starts a new group if the style has changed.
+  /// \param[in] style
+  ///   The group attributes.
+  void UpdateGroup(const std::string& style);
+
+  /// \brief Writes a coordinate or angle.
+  /// \param[in] steps
+  ///   The value, as a number of hundredths of a graphics unit or degree.
+  /// The value is written with integer formatting, so the decimal point does
+  /// not depend on the locale.
+  void WriteSteps(const int64_t& steps);
+
+  /// \var file_
+  ///   The file, which is null if it is not open.
+  std::FILE* file_;
+
+  /// \var is_group_
+  ///   An indicator that tells if a group element is open.
+  bool is_group_;
+
+  /// \var style_
+  ///   The attributes of the open group.
+  std::string style_;
+};
+
+#endif  // APPCOMMON_GRAPHICS_SVG_WRITER_2D_H_
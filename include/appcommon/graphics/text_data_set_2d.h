@@ -4,11 +4,14 @@
 #ifndef APPCOMMON_GRAPHICS_TEXT_DATA_SET_2D_H_
 #define APPCOMMON_GRAPHICS_TEXT_DATA_SET_2D_H_
 
+#include <cstddef>
 #include <list>
 #include <string>
+#include <vector>
 
 #include "models/base/point.h"
 
+#include "appcommon/graphics/arena_2d.h"
 #include "appcommon/graphics/data_set_2d.h"
 
 /// \par OVERVIEW
@@ -53,11 +56,25 @@ struct Text2d {
   /// \var position
   ///   The boundary position of the point.
   BoundaryPosition position;
+
+  /// \var priority
+  ///   The priority used when labels are decluttered. Labels with a higher
+  ///   priority are placed first, and labels with equal priority are placed
+  ///   in dataset order. This defaults to zero.
+  int priority = 0;
 };
 
 /// \par OVERVIEW
 ///
 /// This class represents a set of 2D text.
+///
+/// \par STORAGE
+///
+/// The text elements are constructed in a dataset-owned arena of fixed size
+/// slabs, and Clear() releases the arena at once. The messages are still
+/// std::string values, so only messages that are too long for the small
+/// string buffer need a separate allocation. Text elements that are added by
+/// pointer are kept as is, outside of the arena.
 class TextDataSet2d : public DataSet2d {
  public:
   /// \brief Constructor.
@@ -69,9 +86,17 @@ class TextDataSet2d : public DataSet2d {
   /// \brief Adds text to the dataset.
   /// \param[in] text
   ///   The text.
-  /// This class will take ownership of the pointer.
+  /// This class will take ownership of the pointer, which stays valid until
+  /// the dataset is cleared.
   void Add(const Text2d* text);
 
+  /// \brief Adds a text to the dataset.
+  /// \param[in] text
+  ///   The text.
+  /// The text is constructed in the arena, so no separate allocation is
+  /// needed.
+  void Add(const Text2d& text);
+
   /// \brief Clears all of the stored text.
   void Clear();
 
@@ -91,21 +116,69 @@ class TextDataSet2d : public DataSet2d {
   /// \return The minimum y value.
   float MinY() const override;
 
+  /// \brief Gets the element nearest to a point.
+  /// \param[in] point
+  ///   The point, in data units.
+  /// \param[in] scale_x
+  ///   The factor that scales x data units to graphics units.
+  /// \param[in] scale_y
+  ///   The factor that scales y data units to graphics units.
+  /// \param[in] radius
+  ///   The maximum distance, in graphics units.
+  /// \param[out] index
+  ///   The text index.
+  /// \param[out] distance
+  ///   The distance to the text anchor point, in graphics units.
+  /// \return If a text label was found within the radius.
+  bool Nearest(const Point2d<float>& point, const float& scale_x,
+               const float& scale_y, const float& radius,
+               unsigned int& index, float& distance) const override;
+
+  /// \brief Gets the number of text elements.
+  /// \return The number of text elements.
+  std::size_t Size() const;
+
   /// \brief Gets the data.
   /// \return The data.
+  /// This list is generated from the element storage when it is out of date.
+  /// Use elements() instead when possible.
   const std::list<const Text2d*>* data() const;
 
+  /// \brief Gets the elements.
+  /// \return The elements, in the order they were added.
+  const std::vector<const Text2d*>* elements() const;
+
  private:
-  /// \brief Updates the cached values.
-  void Update() const;
+  /// \brief Adds an element that is already constructed.
+  /// \param[in] text
+  ///   The text, which is owned by the arena or by the pointer list.
+  void AddElement(const Text2d* text);
+
+  /// \brief Updates the spatial index.
+  /// \return If the index was built.
+  bool UpdateIndex() const override;
+
+  /// \var arena_
+  ///   The arena that owns the text storage.
+  Arena2d<Text2d> arena_;
 
   /// \var data_
+  ///   The element pointers that are generated for data().
+  mutable std::list<const Text2d*> data_;
+
+  /// \var elements_
   ///   The text data.
-  std::list<const Text2d*> data_;
+  std::vector<const Text2d*> elements_;
+
+  /// \var is_updated_data_
+  ///   An indicator that tells if the element pointers generated for data()
+  ///   are updated.
+  mutable bool is_updated_data_;
 
-  /// \var is_updated_
-  ///   An indicator that tells if the cached values have been updated.
-  mutable bool is_updated_;
+  /// \var pointers_
+  ///   The elements that were added by pointer, which are deleted when the
+  ///   dataset is cleared.
+  std::vector<const Text2d*> pointers_;
 };
 
 #endif  // APPCOMMON_GRAPHICS_TEXT_DATA_SET_2D_H_
@@ -4,19 +4,95 @@
 #ifndef APPCOMMON_GRAPHICS_TEXT_RENDERER_2D_H_
 #define APPCOMMON_GRAPHICS_TEXT_RENDERER_2D_H_
 
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
 #include "wx/wx.h"
 
 #include "appcommon/graphics/renderer_2d.h"
 #include "appcommon/graphics/text_data_set_2d.h"
 
+/// \par OVERVIEW
+///
+/// This struct is a cached text label.
+struct TextLabel2d {
+  /// \var bitmap
+  ///   The rasterized label, including alpha. This is only valid if the
+  ///   renderer rasterizes labels.
+  wxBitmap bitmap;
+
+  /// \var origin
+  ///   The position of the rotated bounding box upper left corner relative to
+  ///   the text origin.
+  wxPoint origin;
+
+  /// \var size
+  ///   The unrotated text extent.
+  wxSize size;
+
+  /// \var size_rotated
+  ///   The size of the rotated bounding box.
+  wxSize size_rotated;
+};
+
+/// \par OVERVIEW
+///
+/// This struct is a label positioned in graphics coordinates.
+struct TextLabelPosition2d {
+  /// \var label
+  ///   The cached label.
+  const TextLabel2d* label;
+
+  /// \var point
+  ///   The graphics point that the text is drawn from.
+  wxPoint point;
+
+  /// \var point_exact
+  ///   The graphics point that the text is drawn from, without rounding. This
+  ///   is used for exporting.
+  wxRealPoint point_exact;
+
+  /// \var text
+  ///   The text.
+  const Text2d* text;
+};
+
 /// \par OVERVIEW
 ///
 /// This class renders a text dataset onto a plot.
-class TextRenderer2d : public Renderer2d {
+///
+/// \par LABEL CACHE
+///
+/// Measuring and drawing rotated text is expensive, and labels rarely change
+/// between frames. The text extents are cached by message and angle, and the
+/// cache is cleared when the device context font or the text color changes.
+///
+/// The labels can optionally be rasterized into bitmaps with alpha, so repeat
+/// frames only draw a bitmap. The bitmaps are created from the UI thread
+/// device context font, so this should be left disabled when the plot is
+/// rendered asynchronously.
+///
+/// \par DECLUTTER
+///
+/// Labels can optionally be decluttered. The labels are placed in priority
+/// order, and a label is skipped if its rotated bounding box collides with a
+/// label that is already placed. Placed labels are tracked in a screen space
+/// grid, so each label is only tested against nearby labels.
+class TextRenderer2d : public Renderer2dT<TextDataSet2d> {
  public:
   /// \brief Constructor.
   TextRenderer2d();
 
+  /// \brief Clones the renderer.
+  /// \return A new renderer that draws the same dataset with copies of the
+  ///   same styles. The caller takes ownership of the pointer.
+  /// The clone draws text directly instead of rasterizing labels, as
+  /// rasterizing creates a graphics context and a bitmap, which are not safe
+  /// on another thread.
+  Renderer2d* Clone() const override;
+
   /// \brief Draws the data onto the device context.
   /// \param[in] dc
   ///   The device context.
@@ -29,19 +105,142 @@ class TextRenderer2d : public Renderer2d {
   void Draw(wxDC& dc, wxRect rc, const PlotAxis& axis_horizontal,
             const PlotAxis& axis_vertical) const override;
 
+  /// \brief Writes the data to a vector file.
+  /// \param[in] dc
+  ///   The device context that supplies the background colour and text font.
+  /// \param[in] writer
+  ///   The vector file writer.
+  /// \param[in] rc
+  ///   The region to write to.
+  /// \param[in] axis_horizontal
+  ///   The horizontal plot axis.
+  /// \param[in] axis_vertical
+  ///   The vertical plot axis.
+  void Export(wxDC& dc, SvgWriter2d& writer, wxRect rc,
+              const PlotAxis& axis_horizontal,
+              const PlotAxis& axis_vertical) const override;
+
   /// \brief Gets the color of the text.
   /// \return The color of the text.
   const wxColour* color() const;
 
+  /// \brief Gets if colliding labels are skipped.
+  /// \return If colliding labels are skipped.
+  bool is_decluttered() const;
+
+  /// \brief Gets if the labels are rasterized into cached bitmaps.
+  /// \return If the labels are rasterized into cached bitmaps.
+  bool is_rasterized() const;
+
   /// \brief Sets the color of the text.
   /// \param[in] color
   ///   The color.
   void set_color(const wxColour* color);
 
+  /// \brief Sets if colliding labels are skipped.
+  /// \param[in] is_decluttered
+  ///   An indicator that determines if colliding labels are skipped.
+  void set_is_decluttered(const bool& is_decluttered);
+
+  /// \brief Sets if the labels are rasterized into cached bitmaps.
+  /// \param[in] is_rasterized
+  ///   An indicator that determines if the labels are rasterized.
+  void set_is_rasterized(const bool& is_rasterized);
+
  private:
+  /// \brief Gets a cached label, creating it if needed.
+  /// \param[in] dc
+  ///   The device context.
+  /// \param[in] text
+  ///   The text.
+  /// \param[in] color
+  ///   The text color.
+  /// \return The cached label.
+  const TextLabel2d& Label(wxDC& dc, const Text2d& text,
+                           const wxColour& color) const;
+
+  /// \brief Removes labels that collide with higher priority labels.
+  /// \param[in] rc
+  ///   The dc region to draw onto.
+  /// \param[in,out] labels
+  ///   The positioned labels. The labels that are kept are returned in
+  ///   placement order.
+  static void Declutter(const wxRect& rc,
+                        std::vector<TextLabelPosition2d>& labels);
+
+  /// \brief Positions the labels of the visible text.
+  /// \param[in] dc
+  ///   The device context, which measures the text.
+  /// \param[in] color
+  ///   The text color.
+  /// \param[in] points
+  ///   The graphics points of the visible text, which are either wxPoint or
+  ///   wxRealPoint.
+  /// \param[in] indexes
+  ///   The dataset element index of each visible point.
+  /// \param[out] labels
+  ///   The positioned labels, in dataset order.
+  /// The label cache is cleared if the font or color has changed.
+  template <typename T>
+  void PositionLabels(wxDC& dc, const wxColour& color,
+                      const std::vector<T>& points,
+                      const std::vector<unsigned int>& indexes,
+                      std::vector<TextLabelPosition2d>& labels) const;
+
+  /// \brief Rasterizes a label into a bitmap.
+  /// \param[in] dc
+  ///   The device context.
+  /// \param[in] text
+  ///   The text.
+  /// \param[in] color
+  ///   The text color.
+  /// \param[in,out] label
+  ///   The label, which must already have the text extent.
+  static void RasterizeLabel(const wxDC& dc, const Text2d& text,
+                             const wxColour& color, TextLabel2d& label);
+
+  /// \brief Transforms the visible text to graphics coordinates.
+  /// \param[in] rc
+  ///   The dc region to draw onto.
+  /// \param[in] axis_horizontal
+  ///   The horizontal plot axis.
+  /// \param[in] axis_vertical
+  ///   The vertical plot axis.
+  /// \param[out] points
+  ///   The graphics points that are visible.
+  ///   These are wxPoint for drawing, or wxRealPoint for exporting without
+  ///   rounding.
+  /// \param[out] indexes
+  ///   The dataset element index of each visible point.
+  template <typename T>
+  void TransformText(const wxRect& rc, const PlotAxis& axis_horizontal,
+                     const PlotAxis& axis_vertical,
+                     std::vector<T>& points,
+                     std::vector<unsigned int>& indexes) const;
+
+  /// \var color_cache_
+  ///   The text color that the cached labels were created with.
+  mutable wxColour color_cache_;
+
   /// \var color_
   ///   The color of the text.
   const wxColour* color_;
+
+  /// \var font_cache_
+  ///   The description of the font that the cached labels were created with.
+  mutable wxString font_cache_;
+
+  /// \var is_decluttered_
+  ///   An indicator that determines if colliding labels are skipped.
+  bool is_decluttered_;
+
+  /// \var is_rasterized_
+  ///   An indicator that determines if the labels are rasterized.
+  bool is_rasterized_;
+
+  /// \var labels_
+  ///   The cached labels, keyed by message and angle.
+  mutable std::map<std::pair<std::string, float>, TextLabel2d> labels_;
 };
 
 #endif  // APPCOMMON_GRAPHICS_TEXT_RENDERER_2D_H_
@@ -0,0 +1,184 @@
+// This is free and unencumbered software released into the public domain.
+// For more information, please refer to <http://unlicense.org/>
+
+#ifndef APPCOMMON_GRAPHICS_VERTEX_CACHE_2D_H_
+#define APPCOMMON_GRAPHICS_VERTEX_CACHE_2D_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "wx/wx.h"
+
+#include "appcommon/graphics/plot_axis.h"
+
+/// \par OVERVIEW
+///
+/// This class caches the graphics coordinates of a renderer, so they can be
+/// reused while the plot is panned.
+///
+/// \par CACHED REGION
+///
+/// The coordinates are transformed for a region that is larger than the
+/// view, with a guard band on every side. While the view stays within the
+/// cached region at the same scale, the cached coordinates only need an
+/// integer translation. Elements in the guard band are drawn off screen and
+/// clipped by the device context.
+///
+/// \par INVALIDATION
+///
+/// The cache is invalid if the view leaves the cached region, the scale
+/// changes, or the dataset version changes.
+class VertexCache2d {
+ public:
+  /// \brief Constructor.
+  VertexCache2d();
+
+  /// \brief Destructor.
+  ~VertexCache2d();
+
+  /// \brief Clears the cache.
+  void Clear();
+
+  /// \brief Gets if the cache can be used for a view.
+  /// \param[in] axis_horizontal
+  ///   The horizontal plot axis.
+  /// \param[in] axis_vertical
+  ///   The vertical plot axis.
+  /// \param[in] rc
+  ///   The dc region to draw onto.
+  /// \param[in] version
+  ///   The dataset version.
+  /// \return If the cache can be used.
+  bool IsValid(const PlotAxis& axis_horizontal, const PlotAxis& axis_vertical,
+               const wxRect& rc, const uint64_t& version) const;
+
+  /// \brief Gets the cached points that are visible, translated to a view.
+  /// \param[in] axis_horizontal
+  ///   The horizontal plot axis.
+  /// \param[in] axis_vertical
+  ///   The vertical plot axis.
+  /// \param[in] rc
+  ///   The dc region to draw onto.
+  /// \param[out] points
+  ///   The visible graphics points.
+  /// \param[out] indexes
+  ///   The element index of each visible point.
+  void Points(const PlotAxis& axis_horizontal, const PlotAxis& axis_vertical,
+              const wxRect& rc, std::vector<wxPoint>& points,
+              std::vector<unsigned int>& indexes) const;
+
+  /// \brief Gets the region to transform when updating the cache.
+  /// \param[in] axis_horizontal
+  ///   The horizontal plot axis.
+  /// \param[in] axis_vertical
+  ///   The vertical plot axis.
+  /// \param[in] rc
+  ///   The dc region to draw onto.
+  /// \param[out] axis_horizontal_cache
+  ///   The horizontal axis of the cached region.
+  /// \param[out] axis_vertical_cache
+  ///   The vertical axis of the cached region.
+  /// \param[out] rc_cache
+  ///   The graphics rect of the cached region, at the same scale as the view.
+  static void Region(const PlotAxis& axis_horizontal,
+                     const PlotAxis& axis_vertical, const wxRect& rc,
+                     PlotAxis& axis_horizontal_cache,
+                     PlotAxis& axis_vertical_cache, wxRect& rc_cache);
+
+  /// \brief Gets the cached segments that are visible, translated to a view.
+  /// \param[in] axis_horizontal
+  ///   The horizontal plot axis.
+  /// \param[in] axis_vertical
+  ///   The vertical plot axis.
+  /// \param[in] rc
+  ///   The dc region to draw onto.
+  /// \param[out] points
+  ///   The visible segments, stored as consecutive start and end points.
+  void Segments(const PlotAxis& axis_horizontal,
+                const PlotAxis& axis_vertical, const wxRect& rc,
+                std::vector<wxPoint>& points) const;
+
+  /// \brief Updates the cache.
+  /// \param[in] axis_horizontal
+  ///   The horizontal plot axis of the view.
+  /// \param[in] axis_vertical
+  ///   The vertical plot axis of the view.
+  /// \param[in] rc
+  ///   The dc region of the view.
+  /// \param[in] axis_horizontal_cache
+  ///   The horizontal axis of the cached region.
+  /// \param[in] axis_vertical_cache
+  ///   The vertical axis of the cached region.
+  /// \param[in] version
+  ///   The dataset version.
+  /// \param[in] margin
+  ///   The distance (in graphics units) that a point can be outside of the
+  ///   view and still be visible, such as a circle radius.
+  /// \param[in,out] points
+  ///   The graphics points of the cached region. These are swapped into the
+  ///   cache.
+  /// \param[in,out] indexes
+  ///   The element index of each point. This can be empty for segments. These
+  ///   are swapped into the cache.
+  void Update(const PlotAxis& axis_horizontal, const PlotAxis& axis_vertical,
+              const wxRect& rc, const PlotAxis& axis_horizontal_cache,
+              const PlotAxis& axis_vertical_cache, const uint64_t& version,
+              const int& margin, std::vector<wxPoint>& points,
+              std::vector<unsigned int>& indexes);
+
+ private:
+  /// \brief Gets the translation from cached to view graphics coordinates.
+  /// \param[in] axis_horizontal
+  ///   The horizontal plot axis.
+  /// \param[in] axis_vertical
+  ///   The vertical plot axis.
+  /// \return The translation.
+  wxPoint Translation(const PlotAxis& axis_horizontal,
+                      const PlotAxis& axis_vertical) const;
+
+  /// \var indexes_
+  ///   The element index of each cached point.
+  std::vector<unsigned int> indexes_;
+
+  /// \var is_valid_
+  ///   An indicator that tells if the cache contains coordinates.
+  bool is_valid_;
+
+  /// \var margin_
+  ///   The distance that a point can be outside of the view and be visible.
+  int margin_;
+
+  /// \var points_
+  ///   The cached graphics points.
+  std::vector<wxPoint> points_;
+
+  /// \var scale_x_
+  ///   The horizontal scale of the cached coordinates.
+  float scale_x_;
+
+  /// \var scale_y_
+  ///   The vertical scale of the cached coordinates.
+  float scale_y_;
+
+  /// \var version_
+  ///   The dataset version of the cached coordinates.
+  uint64_t version_;
+
+  /// \var x_max_
+  ///   The maximum x value of the cached region.
+  float x_max_;
+
+  /// \var x_min_
+  ///   The minimum x value of the cached region.
+  float x_min_;
+
+  /// \var y_max_
+  ///   The maximum y value of the cached region.
+  float y_max_;
+
+  /// \var y_min_
+  ///   The minimum y value of the cached region.
+  float y_min_;
+};
+
+#endif  // APPCOMMON_GRAPHICS_VERTEX_CACHE_2D_H_
@@ -0,0 +1,168 @@
+// This is free and unencumbered software released into the public domain.
+// For more information, please refer to <http://unlicense.org/>
+
+#include "appcommon/graphics/catenary_data_set_2d.h"
+
+#include <algorithm>
+#include <cmath>
+
+CatenaryDataSet2d::CatenaryDataSet2d() {
+}
+
+CatenaryDataSet2d::~CatenaryDataSet2d() {
+  Clear();
+}
+
+bool CatenaryDataSet2d::Add(const CatenaryCurve2d* catenary) {
+  const bool is_added = Add(*catenary);
+
+  delete catenary;
+
+  return is_added;
+}
+
+bool CatenaryDataSet2d::Add(const CatenaryCurve2d& catenary) {
+  // checks if the curve can be solved, which also rejects a NaN constant
+  if ((catenary.constant > 0) == false) {
+    return false;
+  }
+
+  elements_.push_back(arena_.Emplace(catenary));
+
+  const BoundingBox2d box = Bounds(catenary);
+  ExtendLimits(box.x_min, box.y_min);
+  ExtendLimits(box.x_max, box.y_max);
+  version_++;
+
+  is_updated_index_ = false;
+
+  return true;
+}
+
+BoundingBox2d CatenaryDataSet2d::Bounds(const CatenaryCurve2d& catenary) {
+  BoundingBox2d box;
+  box.x_min = std::min(catenary.x_start, catenary.x_end);
+  box.x_max = std::max(catenary.x_start, catenary.x_end);
+
+  // the curve is convex, so the maximum is at one of the ends
+  const float y_start = PositionY(catenary, catenary.x_start);
+  const float y_end = PositionY(catenary, catenary.x_end);
+  box.y_max = std::max(y_start, y_end);
+
+  // the minimum is at the lowest point if it is within the span
+  if ((box.x_min <= catenary.point_lowest.x)
+      && (catenary.point_lowest.x <= box.x_max)) {
+    box.y_min = catenary.point_lowest.y;
+  } else {
+    box.y_min = std::min(y_start, y_end);
+  }
+
+  return box;
+}
+
+void CatenaryDataSet2d::Clear() {
+  elements_.clear();
+  arena_.Clear();
+
+  ResetLimits();
+  version_++;
+
+  is_updated_index_ = false;
+}
+
+float CatenaryDataSet2d::MaxX() const {
+  return x_max_;
+}
+
+float CatenaryDataSet2d::MaxY() const {
+  return y_max_;
+}
+
+float CatenaryDataSet2d::MinX() const {
+  return x_min_;
+}
+
+float CatenaryDataSet2d::MinY() const {
+  return y_min_;
+}
+
+bool CatenaryDataSet2d::Nearest(const Point2d<float>& point,
+                                const float& scale_x, const float& scale_y,
+                                const float& radius, unsigned int& index,
+                                float& distance) const {
+  // gets the candidate elements
+  // every element is checked if the dataset does not build an index
+  std::vector<unsigned int> indexes;
+  const bool is_queried = IndexesPick(point, scale_x, scale_y, radius,
+                                      indexes);
+
+  // searches for the nearest element
+  // later elements are drawn on top, so they are preferred on ties
+  bool is_found = false;
+  distance = radius;
+  const std::size_t size = (is_queried == true) ? indexes.size()
+                                                : elements_.size();
+  for (std::size_t j = 0; j < size; j++) {
+    const unsigned int i = (is_queried == true) ? indexes[j] : j;
+    const CatenaryCurve2d& catenary = *elements_[i];
+    if (catenary.constant <= 0) {
+      continue;
+    }
+
+    // clamps to the span, and then scales the vertical distance by the
+    // local slope to approximate the perpendicular distance
+    const double x_min = std::min(catenary.x_start, catenary.x_end);
+    const double x_max = std::max(catenary.x_start, catenary.x_end);
+    const double x = std::min(std::max(static_cast<double>(point.x), x_min),
+                              x_max);
+    const double slope = std::sinh((x - catenary.point_lowest.x)
+                                   / catenary.constant) * scale_y / scale_x;
+    const double dx = (x - point.x) * scale_x;
+    const double dy = (PositionY(catenary, x) - point.y) * scale_y
+                      / std::sqrt(1 + slope * slope);
+    const float d = static_cast<float>(std::hypot(dx, dy));
+
+    if (d <= distance) {
+      distance = d;
+      index = i;
+      is_found = true;
+    }
+  }
+
+  return is_found;
+}
+
+double CatenaryDataSet2d::Curvature(const CatenaryCurve2d& catenary,
+                                    const double& x) {
+  const double kConstant = catenary.constant;
+  return std::cosh((x - catenary.point_lowest.x) / kConstant) / kConstant;
+}
+
+double CatenaryDataSet2d::PositionY(const CatenaryCurve2d& catenary,
+                                    const double& x) {
+  const double kConstant = catenary.constant;
+  return catenary.point_lowest.y
+         + kConstant
+           * (std::cosh((x - catenary.point_lowest.x) / kConstant) - 1);
+}
+
+std::size_t CatenaryDataSet2d::Size() const {
+  return elements_.size();
+}
+
+const std::vector<const CatenaryCurve2d*>* CatenaryDataSet2d::elements() const {
+  return &elements_;
+}
+
+bool CatenaryDataSet2d::UpdateIndex() const {
+  std::vector<BoundingBox2d> boxes;
+  boxes.reserve(elements_.size());
+  for (auto iter = elements_.cbegin(); iter != elements_.cend(); iter++) {
+    const CatenaryCurve2d* catenary = *iter;
+    boxes.push_back(Bounds(*catenary));
+  }
+
+  index_.Build(boxes);
+
+  return true;
+}
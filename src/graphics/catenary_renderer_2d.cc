@@ -0,0 +1,189 @@
+// This is free and unencumbered software released into the public domain.
+// For more information, please refer to <http://unlicense.org/>
+
+#include "appcommon/graphics/catenary_renderer_2d.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "appcommon/graphics/graphics_kernel_2d.h"
+
+namespace {
+
+/// The minimum tolerance, in pixels.
+const float kToleranceMin = 0.05f;
+
+}  // namespace
+
+CatenaryRenderer2d::CatenaryRenderer2d() {
+  pen_ = nullptr;
+  tolerance_ = 0.5f;
+}
+
+Renderer2d* CatenaryRenderer2d::Clone() const {
+  CatenaryRenderer2d* renderer = new CatenaryRenderer2d(*this);
+  renderer->pen_ = renderer->CopyStyle(pen_);
+
+  return renderer;
+}
+
+void CatenaryRenderer2d::Draw(wxDC& dc, wxRect rc,
+                              const PlotAxis& axis_horizontal,
+                              const PlotAxis& axis_vertical) const {
+  // sets drawing pen
+  if ((always_contrast_background_ == true)
+       && (pen_->GetColour() == dc.GetBackground().GetColour())) {
+    // gets the inverse color
+    wxColour color_inverse = InvertColor(pen_->GetColour());
+
+    // creates a new pen with the inverted color
+    wxPen pen = *pen_;
+    pen.SetColour(color_inverse);
+
+    // updates dc with inverted pen
+    dc.SetPen(pen);
+  } else {
+    // updates dc with typical pen
+    dc.SetPen(*pen_);
+  }
+
+  // tessellates and transforms the visible catenaries
+  std::vector<wxPoint> points;
+  const std::size_t count = TransformCatenaries(rc, axis_horizontal,
+                                                axis_vertical, points);
+
+  // updates the statistics
+  statistics_.count_drawn = count;
+  statistics_.count_total = dataset()->Size();
+
+  // draws onto DC
+  DrawSegments(dc, points);
+}
+
+void CatenaryRenderer2d::Export(wxDC& dc, SvgWriter2d& writer, wxRect rc,
+                                const PlotAxis& axis_horizontal,
+                                const PlotAxis& axis_vertical) const {
+  // sets the style
+  const wxPen pen = PenContrasted(*pen_, dc.GetBackground().GetColour());
+  writer.SetStyle(&pen, nullptr);
+
+  // tessellates the visible catenaries and writes the visible runs
+  std::vector<wxRealPoint> points;
+  TransformCatenaries(rc, axis_horizontal, axis_vertical, points);
+  writer.WriteSegments(points);
+}
+
+const wxPen* CatenaryRenderer2d::pen() const {
+  return pen_;
+}
+
+void CatenaryRenderer2d::set_pen(const wxPen* pen) {
+  pen_ = pen;
+}
+
+void CatenaryRenderer2d::set_tolerance(const float& tolerance) {
+  tolerance_ = std::max(tolerance, kToleranceMin);
+}
+
+float CatenaryRenderer2d::tolerance() const {
+  return tolerance_;
+}
+
+void CatenaryRenderer2d::Tessellate(
+    const CatenaryCurve2d& catenary, const double& x_min, const double& x_max,
+    const double& scale_x, const double& scale_y,
+    std::vector<float>& x0, std::vector<float>& y0,
+    std::vector<float>& x1, std::vector<float>& y1) const {
+  // the chord error over a step h is approximately h^2 * y'' / 8, so the step
+  // that meets the tolerance is solved from the curvature in graphics units
+  // the step is limited to one pixel, which is as fine as the screen resolves
+  const double step_min = 1 / scale_x;
+  const double factor = 8 * tolerance_ / scale_y;
+
+  double x = x_min;
+  double y = CatenaryDataSet2d::PositionY(catenary, x);
+  while (x < x_max) {
+    // solves the step at the start, and then at the end since the curvature
+    // increases away from the lowest point
+    double step = std::sqrt(factor / CatenaryDataSet2d::Curvature(catenary, x));
+    step = std::max(step, step_min);
+
+    const double x_step = std::min(x + step, x_max);
+    step = std::min(
+        step,
+        std::sqrt(factor / CatenaryDataSet2d::Curvature(catenary, x_step)));
+    step = std::max(step, step_min);
+
+    const double x_next = std::min(x + step, x_max);
+    const double y_next = CatenaryDataSet2d::PositionY(catenary, x_next);
+
+    x0.push_back(x);
+    y0.push_back(y);
+    x1.push_back(x_next);
+    y1.push_back(y_next);
+
+    x = x_next;
+    y = y_next;
+  }
+}
+
+template <typename T>
+std::size_t CatenaryRenderer2d::TransformCatenaries(
+    const wxRect& rc, const PlotAxis& axis_horizontal,
+    const PlotAxis& axis_vertical, std::vector<T>& points) const {
+  // checks if the axes and region are valid
+  points.clear();
+  if ((axis_horizontal.range() <= 0) || (axis_vertical.range() <= 0)
+      || (rc.GetWidth() <= 0) || (rc.GetHeight() <= 0)) {
+    return 0;
+  }
+
+  // gets the typed catenary dataset
+  const CatenaryDataSet2d* dataset = this->dataset();
+  const std::vector<const CatenaryCurve2d*>* elements = dataset->elements();
+
+  // gets the visible catenaries from the spatial index, if available
+  std::vector<unsigned int> indexes;
+  const bool is_indexed = dataset->IndexesVisible(axis_horizontal,
+                                                  axis_vertical, indexes);
+  if (is_indexed == false) {
+    indexes.resize(elements->size());
+    for (std::size_t i = 0; i < indexes.size(); i++) {
+      indexes[i] = i;
+    }
+  }
+
+  // tessellates the visible portion of each catenary
+  const double scale_x = rc.GetWidth() / axis_horizontal.range();
+  const double scale_y = rc.GetHeight() / axis_vertical.range();
+
+  std::vector<float> x0;
+  std::vector<float> y0;
+  std::vector<float> x1;
+  std::vector<float> y1;
+  std::size_t count = 0;
+  for (auto iter = indexes.cbegin(); iter != indexes.cend(); iter++) {
+    const CatenaryCurve2d& catenary = *(*elements)[*iter];
+    if (catenary.constant <= 0) {
+      continue;
+    }
+
+    const double x_min = std::max(
+        std::min(catenary.x_start, catenary.x_end), axis_horizontal.Min());
+    const double x_max = std::min(
+        std::max(catenary.x_start, catenary.x_end), axis_horizontal.Max());
+    if (x_max <= x_min) {
+      continue;
+    }
+
+    Tessellate(catenary, x_min, x_max, scale_x, scale_y, x0, y0, x1, y1);
+    count++;
+  }
+
+  // transforms and clips the segments to the vertical axis
+  const GraphicsKernel2d kernel(axis_horizontal, axis_vertical, rc);
+  kernel.ClipSegments(x0.data(), y0.data(), x1.data(), y1.data(), x0.size(),
+                      points);
+
+  return count;
+}
@@ -4,9 +4,11 @@
 #include "appcommon/graphics/circle_data_set_2d.h"
 
 #include <algorithm>
+#include <cmath>
 
 CircleDataSet2d::CircleDataSet2d() {
-  is_updated_ = false;
+  is_updated_data_ = false;
+  radius_max_ = 0;
 }
 
 CircleDataSet2d::~CircleDataSet2d() {
@@ -14,80 +16,152 @@ CircleDataSet2d::~CircleDataSet2d() {
 }
 
 void CircleDataSet2d::Add(const Circle2d* circle) {
-  data_.push_back(circle);
+  // keeps the pointer, which is deleted when the dataset is cleared
+  pointers_.push_back(circle);
+  AddElement(circle);
+}
 
-  is_updated_ = false;
+void CircleDataSet2d::Add(const Circle2d& circle) {
+  AddElement(arena_.Emplace(circle));
 }
 
 void CircleDataSet2d::Clear() {
-  for (auto iter = data_.begin(); iter != data_.end(); iter++) {
-    const Circle2d* circle = *iter;
-    delete circle;
+  for (auto iter = pointers_.begin(); iter != pointers_.end(); iter++) {
+    delete *iter;
   }
 
+  pointers_.clear();
+  elements_.clear();
+  arena_.Clear();
   data_.clear();
+  radius_max_ = 0;
 
-  is_updated_ = false;
+  ResetLimits();
+  version_++;
+
+  is_updated_data_ = false;
+  is_updated_index_ = false;
 }
 
-float CircleDataSet2d::MaxX() const {
-  if (is_updated_ == false) {
-    Update();
+bool CircleDataSet2d::IndexesVisible(const PlotAxis& axis_horizontal,
+                                     const PlotAxis& axis_vertical,
+                                     const float& scale_x,
+                                     const float& scale_y,
+                                     std::vector<unsigned int>& indexes) const {
+  // checks if the scale can be used to expand the region
+  if ((scale_x <= 0) || (scale_y <= 0)) {
+    return false;
   }
 
+  // queries the visible region, expanded by the largest radius
+  BoundingBox2d region;
+  region.x_min = axis_horizontal.Min() - radius_max_ / scale_x;
+  region.x_max = axis_horizontal.Max() + radius_max_ / scale_x;
+  region.y_min = axis_vertical.Min() - radius_max_ / scale_y;
+  region.y_max = axis_vertical.Max() + radius_max_ / scale_y;
+
+  return IndexesRegion(region, indexes);
+}
+
+float CircleDataSet2d::MaxX() const {
   return x_max_;
 }
 
 float CircleDataSet2d::MaxY() const {
-  if (is_updated_ == false) {
-    Update();
-  }
-
   return y_max_;
 }
 
 float CircleDataSet2d::MinX() const {
-  if (is_updated_ == false) {
-    Update();
-  }
-
   return x_min_;
 }
 
 float CircleDataSet2d::MinY() const {
-  if (is_updated_ == false) {
-    Update();
+  return y_min_;
+}
+
+bool CircleDataSet2d::Nearest(const Point2d<float>& point, const float& scale_x,
+                              const float& scale_y, const float& radius,
+                              unsigned int& index, float& distance) const {
+  // gets the candidate elements
+  // every element is checked if the dataset does not build an index
+  // the index only contains the centers, so the query is expanded by the
+  // largest radius
+  std::vector<unsigned int> indexes;
+  const bool is_queried = IndexesPick(point, scale_x, scale_y,
+                                      radius + radius_max_, indexes);
+
+  // searches for the nearest element
+  // later elements are drawn on top, so they are preferred on ties
+  bool is_found = false;
+  distance = radius;
+  const std::size_t size = (is_queried == true) ? indexes.size()
+                                                : elements_.size();
+  for (std::size_t j = 0; j < size; j++) {
+    const unsigned int i = (is_queried == true) ? indexes[j] : j;
+    // the radius is in graphics units, and the circle is treated as filled
+    const Circle2d* circle = elements_[i];
+    const float d_center = std::hypot((circle->center.x - point.x) * scale_x,
+                                      (circle->center.y - point.y) * scale_y);
+    const float d = std::max(d_center - circle->radius, 0.0f);
+
+    if (d <= distance) {
+      distance = d;
+      index = i;
+      is_found = true;
+    }
   }
 
-  return y_min_;
+  return is_found;
+}
+
+unsigned int CircleDataSet2d::RadiusMax() const {
+  return radius_max_;
+}
+
+std::size_t CircleDataSet2d::Size() const {
+  return elements_.size();
 }
 
 const std::list<const Circle2d*>* CircleDataSet2d::data() const {
+  if (is_updated_data_ == false) {
+    data_.assign(elements_.cbegin(), elements_.cend());
+    is_updated_data_ = true;
+  }
+
   return &data_;
 }
 
-void CircleDataSet2d::Update() const {
-  // initializes
-  x_min_ = 999999;
-  x_max_ = -999999;
+const std::vector<const Circle2d*>* CircleDataSet2d::elements() const {
+  return &elements_;
+}
 
-  y_min_ = 999999;
-  y_max_ = -999999;
+void CircleDataSet2d::AddElement(const Circle2d* circle) {
+  elements_.push_back(circle);
+  radius_max_ = std::max(radius_max_, circle->radius);
 
-  // checks if data exists, exits if not
-  if (data_.empty() == true) {
-    return;
-  }
+  ExtendLimits(circle->center.x, circle->center.y);
+  version_++;
 
-  for (auto iter = data_.cbegin(); iter != data_.cend(); iter++) {
-    const Circle2d* circle = *iter;
+  is_updated_data_ = false;
+  is_updated_index_ = false;
+}
 
-    x_min_ = std::min(circle->center.x, x_min_);
-    x_max_ = std::max(circle->center.x, x_max_);
+bool CircleDataSet2d::UpdateIndex() const {
+  std::vector<BoundingBox2d> boxes;
+  boxes.reserve(elements_.size());
+  for (auto iter = elements_.cbegin(); iter != elements_.cend(); iter++) {
+    const Circle2d* circle = *iter;
 
-    y_min_ = std::min(circle->center.y, y_min_);
-    y_max_ = std::max(circle->center.y, y_max_);
+    // the radius is in graphics units, so only the center is indexed
+    BoundingBox2d box;
+    box.x_min = circle->center.x;
+    box.x_max = circle->center.x;
+    box.y_min = circle->center.y;
+    box.y_max = circle->center.y;
+    boxes.push_back(box);
   }
 
-  is_updated_ = true;
+  index_.Build(boxes);
+
+  return true;
 }
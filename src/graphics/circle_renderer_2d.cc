@@ -3,11 +3,24 @@
 
 #include "appcommon/graphics/circle_renderer_2d.h"
 
+#include <algorithm>
+#include <vector>
+
+#include "appcommon/graphics/graphics_kernel_2d.h"
+
 CircleRenderer2d::CircleRenderer2d() {
   brush_ = nullptr;
   pen_ = nullptr;
 }
 
+Renderer2d* CircleRenderer2d::Clone() const {
+  CircleRenderer2d* renderer = new CircleRenderer2d(*this);
+  renderer->brush_ = renderer->CopyStyle(brush_);
+  renderer->pen_ = renderer->CopyStyle(pen_);
+
+  return renderer;
+}
+
 void CircleRenderer2d::Draw(wxDC& dc, wxRect rc,
                             const PlotAxis& axis_horizontal,
                             const PlotAxis& axis_vertical) const {
@@ -45,44 +58,79 @@ void CircleRenderer2d::Draw(wxDC& dc, wxRect rc,
     dc.SetPen(*pen_);
   }
 
-  // casts to circle dataset
-  const CircleDataSet2d* dataset =
-      dynamic_cast<const CircleDataSet2d*>(dataset_);
-
-  // draws each circle in dataset
-  const std::list<const Circle2d*>* data = dataset->data();
-  for (auto iter = data->cbegin(); iter != data->cend(); iter++) {
-    // gets circle
-    const Circle2d* circle = *iter;
-
-    // gets circle center
-    const float& x = circle->center.x;
-    const float& y = circle->center.y;
-
-    // skips lines that are out of range
-    if ((x + circle->radius) < axis_horizontal.Min()) {
-      continue;
-    } else if (axis_horizontal.Max() < (x - circle->radius)) {
-      continue;
-    } else if ((y + circle->radius) < axis_vertical.Min()) {
-      continue;
-    } else if (axis_vertical.Max() < (y - circle->radius)) {
-      continue;
+  // transforms the visible circles, reusing the cached coordinates if possible
+  std::vector<wxPoint> points;
+  std::vector<unsigned int> indexes;
+  if (is_cached_ == true) {
+    if (cache_.IsValid(axis_horizontal, axis_vertical, rc,
+                       dataset_->version()) == false) {
+      PlotAxis axis_horizontal_cache;
+      PlotAxis axis_vertical_cache;
+      wxRect rc_cache;
+      VertexCache2d::Region(axis_horizontal, axis_vertical, rc,
+                            axis_horizontal_cache, axis_vertical_cache,
+                            rc_cache);
+
+      std::vector<wxPoint> points_cache;
+      std::vector<unsigned int> indexes_cache;
+      TransformCircles(rc_cache, axis_horizontal_cache, axis_vertical_cache,
+                       points_cache, indexes_cache);
+
+      // solves for the largest radius, which is the culling margin
+      const std::vector<const Circle2d*>* data = dataset()->elements();
+      int margin = 0;
+      for (auto iter = indexes_cache.cbegin(); iter != indexes_cache.cend();
+           iter++) {
+        margin = std::max(margin,
+                          static_cast<int>((*data)[*iter]->radius));
+      }
+
+      cache_.Update(axis_horizontal, axis_vertical, rc, axis_horizontal_cache,
+                    axis_vertical_cache, dataset_->version(), margin,
+                    points_cache, indexes_cache);
     }
 
-    // translates center to graphics coordinates
-    wxCoord xg, yg;
+    cache_.Points(axis_horizontal, axis_vertical, rc, points, indexes);
+  } else {
+    TransformCircles(rc, axis_horizontal, axis_vertical, points, indexes);
+  }
 
-    xg = DataToGraphics(x, axis_horizontal.Min(), axis_horizontal.Max(),
-                        rc.GetWidth(), false);
-    yg = DataToGraphics(y, axis_vertical.Min(), axis_vertical.Max(),
-                        rc.GetHeight(), true);
+  // gets the typed circle dataset
+  const CircleDataSet2d* dataset = this->dataset();
+  const std::vector<const Circle2d*>* data = dataset->elements();
 
+  // updates the statistics
+  statistics_.count_drawn = points.size();
+  statistics_.count_total = dataset->Size();
+
+  // draws each visible circle
+  for (std::size_t k = 0; k < points.size(); k++) {
     // translates radius to graphics scale
-    wxCoord rg = static_cast<wxCoord>(circle->radius);
+    const wxCoord rg = static_cast<wxCoord>((*data)[indexes[k]]->radius);
 
     // draws onto DC
-    dc.DrawCircle(xg, yg, rg);
+    dc.DrawCircle(points[k].x, points[k].y, rg);
+  }
+}
+
+void CircleRenderer2d::Export(wxDC& dc, SvgWriter2d& writer, wxRect rc,
+                              const PlotAxis& axis_horizontal,
+                              const PlotAxis& axis_vertical) const {
+  // sets the style
+  const wxColour background = dc.GetBackground().GetColour();
+  const wxBrush brush = BrushContrasted(*brush_, background);
+  const wxPen pen = PenContrasted(*pen_, background);
+  writer.SetStyle(&pen, &brush);
+
+  // transforms the visible circles
+  std::vector<wxRealPoint> points;
+  std::vector<unsigned int> indexes;
+  TransformCircles(rc, axis_horizontal, axis_vertical, points, indexes);
+
+  // writes each visible circle
+  const std::vector<const Circle2d*>* data = dataset()->elements();
+  for (std::size_t k = 0; k < points.size(); k++) {
+    writer.WriteCircle(points[k], (*data)[indexes[k]]->radius);
   }
 }
 
@@ -101,3 +149,46 @@ void CircleRenderer2d::set_brush(const wxBrush* brush) {
 void CircleRenderer2d::set_pen(const wxPen* pen) {
   pen_ = pen;
 }
+
+template <typename T>
+void CircleRenderer2d::TransformCircles(
+    const wxRect& rc, const PlotAxis& axis_horizontal,
+    const PlotAxis& axis_vertical, std::vector<T>& points,
+    std::vector<unsigned int>& indexes) const {
+  // gets the typed circle dataset
+  const CircleDataSet2d* dataset = this->dataset();
+
+  // gets the visible elements from the spatial index, if available
+  // the query is expanded by the largest radius at the graphics scale
+  const std::vector<const Circle2d*>* data = dataset->elements();
+  const float scale_x = rc.GetWidth() / axis_horizontal.range();
+  const float scale_y = rc.GetHeight() / axis_vertical.range();
+  std::vector<unsigned int> indexes_visible;
+  const bool is_indexed = dataset->IndexesVisible(axis_horizontal,
+                                                  axis_vertical, scale_x,
+                                                  scale_y, indexes_visible);
+  const std::size_t count = is_indexed ? indexes_visible.size() : data->size();
+
+  // gathers the circle centers and radii into contiguous arrays
+  std::vector<float> x(count);
+  std::vector<float> y(count);
+  std::vector<float> radii(count);
+  for (std::size_t k = 0; k < count; k++) {
+    const Circle2d* circle = (*data)[is_indexed ? indexes_visible[k] : k];
+    x[k] = circle->center.x;
+    y[k] = circle->center.y;
+    radii[k] = circle->radius;
+  }
+
+  // transforms the centers, culling circles that are out of range
+  const GraphicsKernel2d kernel(axis_horizontal, axis_vertical, rc);
+  kernel.TransformPoints(x.data(), y.data(), radii.data(), count, points,
+                         indexes);
+
+  // maps the gathered array positions back to dataset element indexes
+  if (is_indexed == true) {
+    for (auto iter = indexes.begin(); iter != indexes.end(); iter++) {
+      *iter = indexes_visible[*iter];
+    }
+  }
+}
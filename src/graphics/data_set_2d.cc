@@ -3,7 +3,141 @@
 
 #include "appcommon/graphics/data_set_2d.h"
 
+#include <algorithm>
+#include <cmath>
+
 DataSet2d::DataSet2d() {
+  ResetLimits();
+
+  is_indexed_ = false;
+  is_updated_index_ = false;
+  version_ = 0;
+}
+
+DataSet2d::~DataSet2d() {
+}
+
+bool DataSet2d::IndexesVisible(const PlotAxis& axis_horizontal,
+                               const PlotAxis& axis_vertical,
+                               std::vector<unsigned int>& indexes) const {
+  // queries the visible region
+  BoundingBox2d region;
+  region.x_min = axis_horizontal.Min();
+  region.x_max = axis_horizontal.Max();
+  region.y_min = axis_vertical.Min();
+  region.y_max = axis_vertical.Max();
+
+  return IndexesRegion(region, indexes);
+}
+
+bool DataSet2d::Nearest(const Point2d<float>& point, const float& scale_x,
+                        const float& scale_y, const float& radius,
+                        unsigned int& index, float& distance) const {
+  // placeholder for optional override
+  return false;
+}
+
+void DataSet2d::Prepare() const {
+  // updates the index if needed
+  if ((is_indexed_ == true) && (is_updated_index_ == false)) {
+    is_updated_index_ = UpdateIndex();
+  }
+}
+
+bool DataSet2d::is_indexed() const {
+  return is_indexed_;
+}
+
+void DataSet2d::set_is_indexed(const bool& is_indexed) {
+  is_indexed_ = is_indexed;
+
+  // releases the index memory when disabled
+  if (is_indexed_ == false) {
+    index_.Clear();
+    is_updated_index_ = false;
+  }
+}
+
+uint64_t DataSet2d::version() const {
+  return version_;
+}
+
+float DataSet2d::DistanceSegment(const Point2d<float>& point,
+                                 const float& x0, const float& y0,
+                                 const float& x1, const float& y1,
+                                 const float& scale_x, const float& scale_y) {
+  // converts to graphics units relative to the start point
+  const float dx = (x1 - x0) * scale_x;
+  const float dy = (y1 - y0) * scale_y;
+  const float px = (point.x - x0) * scale_x;
+  const float py = (point.y - y0) * scale_y;
+
+  // solves for the closest position along the segment
+  const float length_squared = dx * dx + dy * dy;
+  float t = 0;
+  if (0 < length_squared) {
+    t = std::min(std::max((px * dx + py * dy) / length_squared, 0.0f), 1.0f);
+  }
+
+  return std::hypot(px - t * dx, py - t * dy);
+}
+
+void DataSet2d::ExtendLimits(const float& x, const float& y) {
+  x_min_ = std::min(x, x_min_);
+  x_max_ = std::max(x, x_max_);
+
+  y_min_ = std::min(y, y_min_);
+  y_max_ = std::max(y, y_max_);
+}
+
+bool DataSet2d::IndexesPick(const Point2d<float>& point,
+                            const float& scale_x, const float& scale_y,
+                            const float& radius,
+                            std::vector<unsigned int>& indexes) const {
+  // updates the index if needed
+  // this is done even if indexing is disabled, as a pick would otherwise
+  // check every element
+  if (is_updated_index_ == false) {
+    is_updated_index_ = UpdateIndex();
+    if (is_updated_index_ == false) {
+      return false;
+    }
+  }
+
+  // queries the region within the radius
+  BoundingBox2d region;
+  region.x_min = point.x - radius / scale_x;
+  region.x_max = point.x + radius / scale_x;
+  region.y_min = point.y - radius / scale_y;
+  region.y_max = point.y + radius / scale_y;
+
+  index_.Query(region, indexes);
+
+  return true;
+}
+
+bool DataSet2d::IndexesRegion(const BoundingBox2d& region,
+                              std::vector<unsigned int>& indexes) const {
+  // checks if indexing is enabled
+  if (is_indexed_ == false) {
+    return false;
+  }
+
+  // updates the index if needed
+  // falls back to every element if the dataset does not build an index
+  if (is_updated_index_ == false) {
+    is_updated_index_ = UpdateIndex();
+    if (is_updated_index_ == false) {
+      return false;
+    }
+  }
+
+  index_.Query(region, indexes);
+
+  return true;
+}
+
+void DataSet2d::ResetLimits() {
   x_max_ = -999999;
   x_min_ = 999999;
 
@@ -11,5 +145,8 @@ DataSet2d::DataSet2d() {
   y_min_ = 999999;
 }
 
-DataSet2d::~DataSet2d() {
+bool DataSet2d::UpdateIndex() const {
+  // placeholder for optional override
+  index_.Clear();
+  return false;
 }
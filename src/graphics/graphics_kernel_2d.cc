@@ -0,0 +1,332 @@
+// This is free and unencumbered software released into the public domain.
+// For more information, please refer to <http://unlicense.org/>
+
+#include "appcommon/graphics/graphics_kernel_2d.h"
+
+#include <algorithm>
+#include <cstdint>
+
+#if defined(__SSE2__) || defined(_M_X64) \
+    || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#define APPCOMMON_GRAPHICS_KERNEL_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace {
+
+#ifdef APPCOMMON_GRAPHICS_KERNEL_SSE2
+/// \brief Clips the segment parameter range against one boundary.
+/// \param[in] p
+///   The Liang-Barsky direction term.
+/// \param[in] q
+///   The Liang-Barsky distance term.
+/// \param[in,out] t0
+///   The start parameter.
+/// \param[in,out] t1
+///   The end parameter.
+/// \param[in,out] reject
+///   The mask of segments that are parallel to and outside of the boundary.
+inline void ClipBoundary(const __m128& p, const __m128& q,
+                         __m128& t0, __m128& t1, __m128& reject) {
+  const __m128 kZero = _mm_setzero_ps();
+  const __m128 r = _mm_div_ps(q, p);
+
+  // entering boundaries raise the start parameter
+  const __m128 mask_entering = _mm_cmplt_ps(p, kZero);
+  t0 = _mm_or_ps(_mm_and_ps(mask_entering, _mm_max_ps(t0, r)),
+                 _mm_andnot_ps(mask_entering, t0));
+
+  // exiting boundaries lower the end parameter
+  const __m128 mask_exiting = _mm_cmpgt_ps(p, kZero);
+  t1 = _mm_or_ps(_mm_and_ps(mask_exiting, _mm_min_ps(t1, r)),
+                 _mm_andnot_ps(mask_exiting, t1));
+
+  // parallel segments are rejected if they are outside the boundary
+  reject = _mm_or_ps(reject, _mm_and_ps(_mm_cmpeq_ps(p, kZero),
+                                        _mm_cmplt_ps(q, kZero)));
+}
+#endif
+
+/// \brief Appends a graphics point, truncating it to integers.
+/// \param[in] x
+///   The graphics x coordinate.
+/// \param[in] y
+///   The graphics y coordinate.
+/// \param[in,out] points
+///   The graphics points.
+inline void AppendPoint(const float& x, const float& y,
+                        std::vector<wxPoint>& points) {
+  points.push_back(wxPoint(static_cast<wxCoord>(x), static_cast<wxCoord>(y)));
+}
+
+/// \brief Appends a graphics point without rounding.
+/// \param[in] x
+///   The graphics x coordinate.
+/// \param[in] y
+///   The graphics y coordinate.
+/// \param[in,out] points
+///   The graphics points.
+inline void AppendPoint(const float& x, const float& y,
+                        std::vector<wxRealPoint>& points) {
+  points.push_back(wxRealPoint(x, y));
+}
+
+}  // namespace
+
+GraphicsKernel2d::GraphicsKernel2d(const PlotAxis& axis_horizontal,
+                                   const PlotAxis& axis_vertical,
+                                   const wxRect& rc) {
+  x_min_ = axis_horizontal.Min();
+  x_max_ = axis_horizontal.Max();
+  y_min_ = axis_vertical.Min();
+  y_max_ = axis_vertical.Max();
+
+  scale_x_ = rc.GetWidth() / (x_max_ - x_min_);
+  scale_y_ = rc.GetHeight() / (y_max_ - y_min_);
+}
+
+GraphicsKernel2d::~GraphicsKernel2d() {
+}
+
+void GraphicsKernel2d::ClipSegments(const float* x0, const float* y0,
+                                    const float* x1, const float* y1,
+                                    const std::size_t& count,
+                                    std::vector<wxPoint>& points) const {
+  std::size_t i = 0;
+
+#ifdef APPCOMMON_GRAPHICS_KERNEL_SSE2
+  const __m128 kZero = _mm_setzero_ps();
+  const __m128 kOne = _mm_set1_ps(1);
+  const __m128 kScaleX = _mm_set1_ps(scale_x_);
+  const __m128 kScaleY = _mm_set1_ps(scale_y_);
+  const __m128 kXMax = _mm_set1_ps(x_max_);
+  const __m128 kXMin = _mm_set1_ps(x_min_);
+  const __m128 kYMax = _mm_set1_ps(y_max_);
+  const __m128 kYMin = _mm_set1_ps(y_min_);
+
+  int32_t xg0[4];
+  int32_t yg0[4];
+  int32_t xg1[4];
+  int32_t yg1[4];
+
+  for (; i + 4 <= count; i += 4) {
+    const __m128 xa = _mm_loadu_ps(x0 + i);
+    const __m128 ya = _mm_loadu_ps(y0 + i);
+    const __m128 dx = _mm_sub_ps(_mm_loadu_ps(x1 + i), xa);
+    const __m128 dy = _mm_sub_ps(_mm_loadu_ps(y1 + i), ya);
+
+    // solves for the visible parameter range
+    __m128 t0 = kZero;
+    __m128 t1 = kOne;
+    __m128 reject = kZero;
+    ClipBoundary(_mm_sub_ps(kZero, dx), _mm_sub_ps(xa, kXMin), t0, t1, reject);
+    ClipBoundary(dx, _mm_sub_ps(kXMax, xa), t0, t1, reject);
+    ClipBoundary(_mm_sub_ps(kZero, dy), _mm_sub_ps(ya, kYMin), t0, t1, reject);
+    ClipBoundary(dy, _mm_sub_ps(kYMax, ya), t0, t1, reject);
+    reject = _mm_or_ps(reject, _mm_cmpgt_ps(t0, t1));
+
+    // skips if all segments are outside
+    const int mask_visible = ~_mm_movemask_ps(reject) & 0xF;
+    if (mask_visible == 0) {
+      continue;
+    }
+
+    // translates the clipped points to graphics coordinates
+    const __m128 xc0 = _mm_add_ps(xa, _mm_mul_ps(t0, dx));
+    const __m128 yc0 = _mm_add_ps(ya, _mm_mul_ps(t0, dy));
+    const __m128 xc1 = _mm_add_ps(xa, _mm_mul_ps(t1, dx));
+    const __m128 yc1 = _mm_add_ps(ya, _mm_mul_ps(t1, dy));
+
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(xg0), _mm_cvttps_epi32(
+        _mm_mul_ps(_mm_sub_ps(xc0, kXMin), kScaleX)));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(yg0), _mm_cvttps_epi32(
+        _mm_mul_ps(_mm_sub_ps(kYMax, yc0), kScaleY)));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(xg1), _mm_cvttps_epi32(
+        _mm_mul_ps(_mm_sub_ps(xc1, kXMin), kScaleX)));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(yg1), _mm_cvttps_epi32(
+        _mm_mul_ps(_mm_sub_ps(kYMax, yc1), kScaleY)));
+
+    // adds the visible segments
+    for (int lane = 0; lane < 4; lane++) {
+      if ((mask_visible & (1 << lane)) == 0) {
+        continue;
+      }
+
+      points.push_back(wxPoint(xg0[lane], yg0[lane]));
+      points.push_back(wxPoint(xg1[lane], yg1[lane]));
+    }
+  }
+#endif
+
+  // processes any remaining segments
+  ClipSegmentsScalar(x0, y0, x1, y1, i, count, points);
+}
+
+void GraphicsKernel2d::ClipSegments(const float* x0, const float* y0,
+                                    const float* x1, const float* y1,
+                                    const std::size_t& count,
+                                    std::vector<wxRealPoint>& points) const {
+  ClipSegmentsRange(x0, y0, x1, y1, 0, count, points);
+}
+
+bool GraphicsKernel2d::IsVectorized() {
+#ifdef APPCOMMON_GRAPHICS_KERNEL_SSE2
+  return true;
+#else
+  return false;
+#endif
+}
+
+void GraphicsKernel2d::TransformPoints(
+    const float* x, const float* y, const float* margins,
+    const std::size_t& count,
+    std::vector<wxPoint>& points,
+    std::vector<unsigned int>& indexes) const {
+  points.clear();
+  indexes.clear();
+
+  std::size_t i = 0;
+
+#ifdef APPCOMMON_GRAPHICS_KERNEL_SSE2
+  const __m128 kScaleX = _mm_set1_ps(scale_x_);
+  const __m128 kScaleY = _mm_set1_ps(scale_y_);
+  const __m128 kXMax = _mm_set1_ps(x_max_);
+  const __m128 kXMin = _mm_set1_ps(x_min_);
+  const __m128 kYMax = _mm_set1_ps(y_max_);
+  const __m128 kYMin = _mm_set1_ps(y_min_);
+
+  int32_t xg[4];
+  int32_t yg[4];
+
+  for (; i + 4 <= count; i += 4) {
+    const __m128 xv = _mm_loadu_ps(x + i);
+    const __m128 yv = _mm_loadu_ps(y + i);
+    const __m128 margin = (margins == nullptr) ? _mm_setzero_ps()
+                                               : _mm_loadu_ps(margins + i);
+
+    // culls points outside of the axes
+    // comparisons with NaN are false, so those points are culled as well
+    __m128 visible = _mm_cmpge_ps(xv, _mm_sub_ps(kXMin, margin));
+    visible = _mm_and_ps(visible, _mm_cmple_ps(xv, _mm_add_ps(kXMax, margin)));
+    visible = _mm_and_ps(visible, _mm_cmpge_ps(yv, _mm_sub_ps(kYMin, margin)));
+    visible = _mm_and_ps(visible, _mm_cmple_ps(yv, _mm_add_ps(kYMax, margin)));
+
+    const int mask_visible = _mm_movemask_ps(visible);
+    if (mask_visible == 0) {
+      continue;
+    }
+
+    // translates to graphics coordinates
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(xg), _mm_cvttps_epi32(
+        _mm_mul_ps(_mm_sub_ps(xv, kXMin), kScaleX)));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(yg), _mm_cvttps_epi32(
+        _mm_mul_ps(_mm_sub_ps(kYMax, yv), kScaleY)));
+
+    // adds the visible points
+    for (int lane = 0; lane < 4; lane++) {
+      if ((mask_visible & (1 << lane)) == 0) {
+        continue;
+      }
+
+      points.push_back(wxPoint(xg[lane], yg[lane]));
+      indexes.push_back(static_cast<unsigned int>(i + lane));
+    }
+  }
+#endif
+
+  // processes any remaining points
+  TransformPointsScalar(x, y, margins, i, count, points, indexes);
+}
+
+void GraphicsKernel2d::TransformPoints(
+    const float* x, const float* y, const float* margins,
+    const std::size_t& count,
+    std::vector<wxRealPoint>& points,
+    std::vector<unsigned int>& indexes) const {
+  points.clear();
+  indexes.clear();
+
+  TransformPointsScalar(x, y, margins, 0, count, points, indexes);
+}
+
+void GraphicsKernel2d::ClipSegmentsScalar(const float* x0, const float* y0,
+                                          const float* x1, const float* y1,
+                                          const std::size_t& index_begin,
+                                          const std::size_t& index_end,
+                                          std::vector<wxPoint>& points) const {
+  ClipSegmentsRange(x0, y0, x1, y1, index_begin, index_end, points);
+}
+
+template <typename T>
+void GraphicsKernel2d::ClipSegmentsRange(const float* x0, const float* y0,
+                                         const float* x1, const float* y1,
+                                         const std::size_t& index_begin,
+                                         const std::size_t& index_end,
+                                         std::vector<T>& points) const {
+  for (std::size_t i = index_begin; i < index_end; i++) {
+    const float xa = x0[i];
+    const float ya = y0[i];
+    const float dx = x1[i] - xa;
+    const float dy = y1[i] - ya;
+
+    // solves for the visible parameter range
+    const float p[4] = {-dx, dx, -dy, dy};
+    const float q[4] = {xa - x_min_, x_max_ - xa, ya - y_min_, y_max_ - ya};
+
+    float t0 = 0;
+    float t1 = 1;
+    bool is_visible = true;
+    for (int j = 0; j < 4; j++) {
+      if (p[j] == 0) {
+        // parallel segments are rejected if they are outside the boundary
+        if (q[j] < 0) {
+          is_visible = false;
+          break;
+        }
+      } else {
+        const float r = q[j] / p[j];
+        if (p[j] < 0) {
+          t0 = std::max(t0, r);
+        } else {
+          t1 = std::min(t1, r);
+        }
+      }
+    }
+
+    if ((is_visible == false) || (t1 < t0)) {
+      continue;
+    }
+
+    // translates the clipped points to graphics coordinates
+    AppendPoint((xa + t0 * dx - x_min_) * scale_x_,
+                (y_max_ - (ya + t0 * dy)) * scale_y_, points);
+    AppendPoint((xa + t1 * dx - x_min_) * scale_x_,
+                (y_max_ - (ya + t1 * dy)) * scale_y_, points);
+  }
+}
+
+template <typename T>
+void GraphicsKernel2d::TransformPointsScalar(
+    const float* x, const float* y, const float* margins,
+    const std::size_t& index_begin,
+    const std::size_t& index_end,
+    std::vector<T>& points,
+    std::vector<unsigned int>& indexes) const {
+  for (std::size_t i = index_begin; i < index_end; i++) {
+    const float margin = (margins == nullptr) ? 0 : margins[i];
+
+    // culls points outside of the axes
+    const bool is_visible = (x_min_ - margin <= x[i])
+                            && (x[i] <= x_max_ + margin)
+                            && (y_min_ - margin <= y[i])
+                            && (y[i] <= y_max_ + margin);
+    if (is_visible == false) {
+      continue;
+    }
+
+    // translates to graphics coordinates
+    AppendPoint((x[i] - x_min_) * scale_x_, (y_max_ - y[i]) * scale_y_,
+                points);
+    indexes.push_back(static_cast<unsigned int>(i));
+  }
+}
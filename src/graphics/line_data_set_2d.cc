@@ -4,9 +4,11 @@
 #include "appcommon/graphics/line_data_set_2d.h"
 
 #include <algorithm>
+#include <cmath>
 
 LineDataSet2d::LineDataSet2d() {
-  is_updated_ = false;
+  is_decimated_ = false;
+  is_updated_pyramid_ = false;
 }
 
 LineDataSet2d::~LineDataSet2d() {
@@ -14,84 +16,246 @@ LineDataSet2d::~LineDataSet2d() {
 }
 
 void LineDataSet2d::Add(const Line2d* line) {
+  // keeps the pointer at the index of the line, which is deleted when the
+  // dataset is cleared
+  UpdateAdapter();
   data_.push_back(line);
 
-  is_updated_ = false;
+  Add(*line);
 }
 
-void LineDataSet2d::Clear() {
-  for (auto iter = data_.begin(); iter != data_.end(); iter++) {
-    const Line2d* line = *iter;
-    delete line;
+void LineDataSet2d::Add(const Line2d& line) {
+  x0_.push_back(line.p0.x);
+  y0_.push_back(line.p0.y);
+  x1_.push_back(line.p1.x);
+  y1_.push_back(line.p1.y);
+
+  ExtendLimits(line.p0.x, line.p0.y);
+  ExtendLimits(line.p1.x, line.p1.y);
+  version_++;
+
+  is_updated_index_ = false;
+  is_updated_pyramid_ = false;
+}
+
+void LineDataSet2d::AddRange(const Line2d* lines, const std::size_t& count) {
+  Reserve(x0_.size() + count);
+
+  for (std::size_t i = 0; i < count; i++) {
+    const Line2d& line = lines[i];
+    x0_.push_back(line.p0.x);
+    y0_.push_back(line.p0.y);
+    x1_.push_back(line.p1.x);
+    y1_.push_back(line.p1.y);
+
+    ExtendLimits(line.p0.x, line.p0.y);
+    ExtendLimits(line.p1.x, line.p1.y);
   }
 
-  data_.clear();
+  version_++;
 
-  is_updated_ = false;
+  is_updated_index_ = false;
+  is_updated_pyramid_ = false;
 }
 
-float LineDataSet2d::MaxX() const {
-  if (is_updated_ == false) {
-    Update();
+void LineDataSet2d::AddRange(const float* x0, const float* y0,
+                             const float* x1, const float* y1,
+                             const std::size_t& count) {
+  x0_.insert(x0_.end(), x0, x0 + count);
+  y0_.insert(y0_.end(), y0, y0 + count);
+  x1_.insert(x1_.end(), x1, x1 + count);
+  y1_.insert(y1_.end(), y1, y1 + count);
+
+  for (std::size_t i = 0; i < count; i++) {
+    ExtendLimits(x0[i], y0[i]);
+    ExtendLimits(x1[i], y1[i]);
   }
 
-  return x_max_;
+  version_++;
+
+  is_updated_index_ = false;
+  is_updated_pyramid_ = false;
 }
 
-float LineDataSet2d::MaxY() const {
-  if (is_updated_ == false) {
-    Update();
+void LineDataSet2d::Clear() {
+  ClearAdapter();
+
+  x0_.clear();
+  y0_.clear();
+  x1_.clear();
+  y1_.clear();
+
+  ResetLimits();
+  version_++;
+
+  is_updated_index_ = false;
+  is_updated_pyramid_ = false;
+}
+
+std::size_t LineDataSet2d::Decimate(const PlotAxis& axis_horizontal,
+                                   const int& num_columns,
+                                   std::vector<MinMaxBin2d>& columns) const {
+  // checks if decimation is enabled
+  if (is_decimated_ == false) {
+    columns.clear();
+    return 0;
   }
 
+  // updates the pyramid if needed
+  UpdatePyramid();
+
+  return pyramid_.Query(axis_horizontal.Min(), axis_horizontal.Max(),
+                        num_columns, columns);
+}
+
+Line2d LineDataSet2d::Line(const std::size_t& index) const {
+  Line2d line;
+  line.p0.x = x0_[index];
+  line.p0.y = y0_[index];
+  line.p1.x = x1_[index];
+  line.p1.y = y1_[index];
+
+  return line;
+}
+
+float LineDataSet2d::MaxX() const {
+  return x_max_;
+}
+
+float LineDataSet2d::MaxY() const {
   return y_max_;
 }
 
 float LineDataSet2d::MinX() const {
-  if (is_updated_ == false) {
-    Update();
-  }
-
   return x_min_;
 }
 
 float LineDataSet2d::MinY() const {
-  if (is_updated_ == false) {
-    Update();
+  return y_min_;
+}
+
+bool LineDataSet2d::Nearest(const Point2d<float>& point, const float& scale_x,
+                            const float& scale_y, const float& radius,
+                            unsigned int& index, float& distance) const {
+  // gets the candidate elements
+  // every element is checked if the dataset does not build an index
+  std::vector<unsigned int> indexes;
+  const bool is_queried = IndexesPick(point, scale_x, scale_y, radius,
+                                      indexes);
+
+  // searches for the nearest element
+  // later elements are drawn on top, so they are preferred on ties
+  bool is_found = false;
+  distance = radius;
+  const std::size_t size = (is_queried == true) ? indexes.size()
+                                                : x0_.size();
+  for (std::size_t j = 0; j < size; j++) {
+    const unsigned int i = (is_queried == true) ? indexes[j] : j;
+    const float d = DistanceSegment(point, x0_[i], y0_[i], x1_[i], y1_[i],
+                                    scale_x, scale_y);
+
+    if (d <= distance) {
+      distance = d;
+      index = i;
+      is_found = true;
+    }
   }
 
-  return y_min_;
+  return is_found;
+}
+
+void LineDataSet2d::Prepare() const {
+  DataSet2d::Prepare();
+
+  if (is_decimated_ == true) {
+    UpdatePyramid();
+  }
+}
+
+void LineDataSet2d::Reserve(const std::size_t& count) {
+  x0_.reserve(count);
+  y0_.reserve(count);
+  x1_.reserve(count);
+  y1_.reserve(count);
+}
+
+std::size_t LineDataSet2d::Size() const {
+  return x0_.size();
+}
+
+LineDataSpan2d LineDataSet2d::Span() const {
+  LineDataSpan2d span;
+  span.size = x0_.size();
+  span.x0 = x0_.data();
+  span.y0 = y0_.data();
+  span.x1 = x1_.data();
+  span.y1 = y1_.data();
+
+  return span;
+}
+
+bool LineDataSet2d::is_decimated() const {
+  return is_decimated_;
+}
+
+void LineDataSet2d::set_is_decimated(const bool& is_decimated) {
+  is_decimated_ = is_decimated;
+
+  // releases the pyramid memory when disabled
+  if (is_decimated_ == false) {
+    pyramid_.Clear();
+    is_updated_pyramid_ = false;
+  }
 }
 
 const std::list<const Line2d*>* LineDataSet2d::data() const {
+  UpdateAdapter();
+
   return &data_;
 }
 
-void LineDataSet2d::Update() const {
-  // initializes
-  x_min_ = 999999;
-  x_max_ = -999999;
+void LineDataSet2d::ClearAdapter() const {
+  for (auto iter = data_.begin(); iter != data_.end(); iter++) {
+    const Line2d* line = *iter;
+    delete line;
+  }
+
+  data_.clear();
+}
 
-  y_min_ = 999999;
-  y_max_ = -999999;
+bool LineDataSet2d::UpdateIndex() const {
+  const std::size_t size = x0_.size();
 
-  // checks if data exists, exits if not
-  if (data_.empty() == true) {
-    return;
+  std::vector<BoundingBox2d> boxes;
+  boxes.reserve(size);
+  for (std::size_t i = 0; i < size; i++) {
+    BoundingBox2d box;
+    box.x_min = std::min(x0_[i], x1_[i]);
+    box.x_max = std::max(x0_[i], x1_[i]);
+    box.y_min = std::min(y0_[i], y1_[i]);
+    box.y_max = std::max(y0_[i], y1_[i]);
+    boxes.push_back(box);
   }
 
-  for (auto iter = data_.cbegin(); iter != data_.cend(); iter++) {
-    const Line2d* line = *iter;
+  index_.Build(boxes);
 
-    x_min_ = std::min(line->p0.x, x_min_);
-    x_min_ = std::min(line->p1.x, x_min_);
-    x_max_ = std::max(line->p0.x, x_max_);
-    x_max_ = std::max(line->p1.x, x_max_);
+  return true;
+}
 
-    y_min_ = std::min(line->p0.y, y_min_);
-    y_min_ = std::min(line->p1.y, y_min_);
-    y_max_ = std::max(line->p0.y, y_max_);
-    y_max_ = std::max(line->p1.y, y_max_);
+void LineDataSet2d::UpdateAdapter() const {
+  // generates pointers for the lines that were added since the last update
+  // the existing pointers are kept, so they stay valid until the dataset is
+  // cleared
+  for (std::size_t i = data_.size(); i < x0_.size(); i++) {
+    data_.push_back(new Line2d(Line(i)));
+  }
+}
+
+void LineDataSet2d::UpdatePyramid() const {
+  if (is_updated_pyramid_ == true) {
+    return;
   }
 
-  is_updated_ = true;
+  pyramid_.Build(x0_.data(), y0_.data(), x1_.data(), y1_.data(), x0_.size());
+  is_updated_pyramid_ = true;
 }
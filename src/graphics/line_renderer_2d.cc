@@ -3,10 +3,46 @@
 
 #include "appcommon/graphics/line_renderer_2d.h"
 
+#include <algorithm>
+#include <vector>
+
+#include "appcommon/graphics/graphics_kernel_2d.h"
+
+namespace {
+
+/// The number of lines that are transformed and written at a time when
+/// exporting.
+const std::size_t kSizeChunkExport = 65536;
+
+/// \brief Transforms a vertical data value to graphics coordinates, like
+///   Renderer2d::DataToGraphics() but without truncating.
+/// \param[in] value
+///   The data value.
+/// \param[in] axis_vertical
+///   The vertical plot axis.
+/// \param[in] height
+///   The graphics height of the axis.
+/// \return The graphics coordinate.
+float GraphicsVertical(const float& value, const PlotAxis& axis_vertical,
+                       const int& height) {
+  const float k = (axis_vertical.Max() - value)
+                  / (axis_vertical.Max() - axis_vertical.Min());
+  return k * height;
+}
+
+}  // namespace
+
 LineRenderer2d::LineRenderer2d() {
   pen_ = nullptr;
 }
 
+Renderer2d* LineRenderer2d::Clone() const {
+  LineRenderer2d* renderer = new LineRenderer2d(*this);
+  renderer->pen_ = renderer->CopyStyle(pen_);
+
+  return renderer;
+}
+
 void LineRenderer2d::Draw(wxDC& dc, wxRect rc, const PlotAxis& axis_horizontal,
                           const PlotAxis& axis_vertical) const {
   // sets drawing pen
@@ -26,64 +62,95 @@ void LineRenderer2d::Draw(wxDC& dc, wxRect rc, const PlotAxis& axis_horizontal,
     dc.SetPen(*pen_);
   }
 
-  // casts to line dataset
-  const LineDataSet2d* dataset = dynamic_cast<const LineDataSet2d*>(dataset_);
+  // gets the typed line dataset
+  const LineDataSet2d* dataset = this->dataset();
 
-  // draws each line in dataset
-  const std::list<const Line2d*>* data = dataset->data();
-  for (auto iter = data->cbegin(); iter != data->cend(); iter++) {
-    // gets line
-    const Line2d* line = *iter;
+  // draws a column for each pixel if the lines are denser than the pixels
+  if (dataset->is_decimated() == true) {
+    std::vector<MinMaxBin2d> columns;
+    const std::size_t count = dataset->Decimate(axis_horizontal, rc.GetWidth(),
+                                                columns);
+    if (static_cast<std::size_t>(2 * rc.GetWidth()) < count) {
+      std::vector<wxPoint> points;
+      TransformColumns(rc, axis_vertical, columns, points);
 
-    // gets points to draw
-    float x0 = line->p0.x;
-    float y0 = line->p0.y;
-    float x1 = line->p1.x;
-    float y1 = line->p1.y;
+      // updates the statistics, counting each column span as a drawn element
+      statistics_.count_drawn = points.size() / 2;
+      statistics_.count_total = dataset->Size();
 
-    // skips lines that are out of range
-    if ((x0 < axis_horizontal.Min()) && (x1 < axis_horizontal.Min())) {
-      continue;
-    } else if ((axis_horizontal.Max() < x0) && (axis_horizontal.Max() < x1)) {
-      continue;
-    } else if ((y0 < axis_vertical.Min()) && (y1 < axis_vertical.Min())) {
-      continue;
-    } else if ((axis_vertical.Max() < y0) && (axis_vertical.Max() < y1)) {
-      continue;
+      DrawSegments(dc, points);
+      return;
     }
+  }
 
-    // clips points to edge of axis if necessary
-    if (axis_horizontal.IsVisible(x0) == false) {
-      ClipHorizontal(axis_horizontal, x1, y1, x0, y0);
-    }
+  // transforms the visible lines, reusing the cached coordinates if possible
+  std::vector<wxPoint> points;
+  if (is_cached_ == true) {
+    if (cache_.IsValid(axis_horizontal, axis_vertical, rc,
+                       dataset->version()) == false) {
+      PlotAxis axis_horizontal_cache;
+      PlotAxis axis_vertical_cache;
+      wxRect rc_cache;
+      VertexCache2d::Region(axis_horizontal, axis_vertical, rc,
+                            axis_horizontal_cache, axis_vertical_cache,
+                            rc_cache);
 
-    if (axis_vertical.IsVisible(y0) == false) {
-      ClipVertical(axis_vertical, x1, y1, x0, y0);
+      std::vector<wxPoint> points_cache;
+      std::vector<unsigned int> indexes_cache;
+      TransformLines(rc_cache, axis_horizontal_cache, axis_vertical_cache,
+                     points_cache);
+      cache_.Update(axis_horizontal, axis_vertical, rc, axis_horizontal_cache,
+                    axis_vertical_cache, dataset->version(), 0, points_cache,
+                    indexes_cache);
     }
 
-    if (axis_horizontal.IsVisible(x1) == false) {
-      ClipHorizontal(axis_horizontal, x0, y0, x1, y1);
-    }
+    cache_.Segments(axis_horizontal, axis_vertical, rc, points);
+  } else {
+    TransformLines(rc, axis_horizontal, axis_vertical, points);
+  }
+
+  // updates the statistics
+  statistics_.count_drawn = points.size() / 2;
+  statistics_.count_total = dataset->Size();
 
-    if (axis_vertical.IsVisible(y1) == false) {
-      ClipVertical(axis_vertical, x0, y0, x1, y1);
+  // draws onto DC
+  DrawSegments(dc, points);
+}
+
+void LineRenderer2d::Export(wxDC& dc, SvgWriter2d& writer, wxRect rc,
+                            const PlotAxis& axis_horizontal,
+                            const PlotAxis& axis_vertical) const {
+  // sets the style
+  const wxPen pen = PenContrasted(*pen_, dc.GetBackground().GetColour());
+  writer.SetStyle(&pen, nullptr);
+
+  // gets the typed line dataset
+  const LineDataSet2d* dataset = this->dataset();
+
+  // writes a column for each pixel if the lines are denser than the pixels
+  std::vector<wxRealPoint> points;
+  if (dataset->is_decimated() == true) {
+    std::vector<MinMaxBin2d> columns;
+    const std::size_t count = dataset->Decimate(axis_horizontal, rc.GetWidth(),
+                                                columns);
+    if (static_cast<std::size_t>(2 * rc.GetWidth()) < count) {
+      TransformColumns(rc, axis_vertical, columns, points);
+      writer.WriteSegments(points);
+      return;
     }
+  }
 
-    // translates to graphics coordinates
-    wxCoord xg0, yg0;
-    wxCoord xg1, yg1;
-
-    xg0 = DataToGraphics(x0, axis_horizontal.Min(), axis_horizontal.Max(),
-                         rc.GetWidth(), false);
-    yg0 = DataToGraphics(y0, axis_vertical.Min(), axis_vertical.Max(),
-                         rc.GetHeight(), true);
-    xg1 = DataToGraphics(x1, axis_horizontal.Min(), axis_horizontal.Max(),
-                         rc.GetWidth(), false);
-    yg1 = DataToGraphics(y1, axis_vertical.Min(), axis_vertical.Max(),
-                         rc.GetHeight(), true);
-
-    // draws onto DC
-    dc.DrawLine(xg0, yg0, xg1, yg1);
+  // transforms, clips, and writes the lines in fixed size chunks, so the
+  // memory does not grow with the dataset
+  const LineDataSpan2d data = dataset->Span();
+  const GraphicsKernel2d kernel(axis_horizontal, axis_vertical, rc);
+  for (std::size_t begin = 0; begin < data.size; begin += kSizeChunkExport) {
+    const std::size_t count = std::min(kSizeChunkExport, data.size - begin);
+
+    points.clear();
+    kernel.ClipSegments(data.x0 + begin, data.y0 + begin, data.x1 + begin,
+                        data.y1 + begin, count, points);
+    writer.WriteSegments(points);
   }
 }
 
@@ -94,3 +161,101 @@ const wxPen* LineRenderer2d::pen() const {
 void LineRenderer2d::set_pen(const wxPen* pen) {
   pen_ = pen;
 }
+
+template <typename T>
+void LineRenderer2d::TransformColumns(
+    const wxRect& rc, const PlotAxis& axis_vertical,
+    const std::vector<MinMaxBin2d>& columns, std::vector<T>& points) {
+  points.clear();
+
+  bool is_connectable = false;
+  float y_max_previous = 0;
+  float y_min_previous = 0;
+  for (std::size_t index = 0; index < columns.size(); index++) {
+    const MinMaxBin2d& column = columns[index];
+
+    // skips empty columns and columns outside the vertical axis
+    if ((column.count == 0)
+        || (column.y_max < axis_vertical.Min())
+        || (axis_vertical.Max() < column.y_min)) {
+      is_connectable = false;
+      continue;
+    }
+
+    // clips the column to the vertical axis
+    const float y_min = std::max(column.y_min, axis_vertical.Min());
+    const float y_max = std::min(column.y_max, axis_vertical.Max());
+    const bool is_clipped = (y_min != column.y_min) || (y_max != column.y_max);
+
+    // translates to graphics coordinates
+    // a wxPoint truncates these for drawing, and a wxRealPoint keeps them for
+    // exporting
+    const float xg = static_cast<float>(index);
+    const float yg_min = GraphicsVertical(y_min, axis_vertical,
+                                          rc.GetHeight());
+    const float yg_max = GraphicsVertical(y_max, axis_vertical,
+                                          rc.GetHeight());
+
+    // alternates the span direction so that overlapping spans can be joined
+    // end to end
+    T point_start(xg, yg_min);
+    T point_end(xg, yg_max);
+    if (index % 2 == 1) {
+      std::swap(point_start, point_end);
+    }
+
+    // joins the previous span if the extents overlap
+    if ((is_connectable == true)
+        && (y_min <= y_max_previous) && (y_min_previous <= y_max)) {
+      points.push_back(points.back());
+      points.push_back(point_start);
+    }
+
+    points.push_back(point_start);
+    points.push_back(point_end);
+
+    is_connectable = !is_clipped;
+    y_max_previous = y_max;
+    y_min_previous = y_min;
+  }
+}
+
+void LineRenderer2d::TransformLines(const wxRect& rc,
+                                    const PlotAxis& axis_horizontal,
+                                    const PlotAxis& axis_vertical,
+                                    std::vector<wxPoint>& points) const {
+  // gets the typed line dataset
+  const LineDataSet2d* dataset = this->dataset();
+
+  // gets the visible lines from the spatial index, if available
+  const LineDataSpan2d data = dataset->Span();
+  std::vector<unsigned int> indexes;
+  const bool is_indexed = dataset->IndexesVisible(axis_horizontal,
+                                                  axis_vertical, indexes);
+
+  // transforms and clips the lines into the point buffer
+  const GraphicsKernel2d kernel(axis_horizontal, axis_vertical, rc);
+  points.clear();
+  if (is_indexed == true) {
+    // gathers the visible lines into contiguous arrays
+    const std::size_t count = indexes.size();
+    std::vector<float> x0(count);
+    std::vector<float> y0(count);
+    std::vector<float> x1(count);
+    std::vector<float> y1(count);
+    for (std::size_t k = 0; k < count; k++) {
+      const unsigned int i = indexes[k];
+      x0[k] = data.x0[i];
+      y0[k] = data.y0[i];
+      x1[k] = data.x1[i];
+      y1[k] = data.y1[i];
+    }
+
+    kernel.ClipSegments(x0.data(), y0.data(), x1.data(), y1.data(), count,
+                        points);
+  } else {
+    kernel.ClipSegments(data.x0, data.y0, data.x1, data.y1, data.size,
+                        points);
+  }
+}
+
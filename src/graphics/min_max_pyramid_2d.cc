@@ -0,0 +1,300 @@
+// This is free and unencumbered software released into the public domain.
+// For more information, please refer to <http://unlicense.org/>
+
+#include "appcommon/graphics/min_max_pyramid_2d.h"
+
+#include <algorithm>
+
+namespace {
+
+/// The maximum number of bins in the first pyramid level.
+const std::size_t kNumBinsMax = 262144;
+
+/// The minimum number of bins in the first pyramid level.
+const std::size_t kNumBinsMin = 64;
+
+/// The minimum number of bins that are merged into a column. Bins on the
+/// column edges are only partially within the column, so using several bins
+/// keeps the overlap into neighboring columns small.
+const int kNumBinsColumn = 4;
+
+/// The maximum number of bins a line passes through within the level it is
+/// inserted into.
+const std::size_t kNumBinsSegment = 4;
+
+}  // namespace
+
+MinMaxPyramid2d::MinMaxPyramid2d() {
+  Clear();
+}
+
+MinMaxPyramid2d::~MinMaxPyramid2d() {
+}
+
+void MinMaxPyramid2d::Build(const float* x0, const float* y0,
+                            const float* x1, const float* y1,
+                            const std::size_t& size) {
+  Clear();
+
+  // checks if any lines exist
+  if (size == 0) {
+    return;
+  }
+
+  // solves for the horizontal extents
+  for (std::size_t i = 0; i < size; i++) {
+    x_min_ = std::min(x_min_, std::min(x0[i], x1[i]));
+    x_max_ = std::max(x_max_, std::max(x0[i], x1[i]));
+  }
+
+  // sizes the first level to roughly match the number of lines
+  std::size_t num_bins = kNumBinsMin;
+  while ((num_bins < size) && (num_bins < kNumBinsMax)) {
+    num_bins *= 2;
+  }
+
+  width_bin_ = (x_max_ - x_min_) / num_bins;
+
+  MinMaxBin2d bin_empty;
+  bin_empty.count = 0;
+  bin_empty.y_max = -999999;
+  bin_empty.y_min = 999999;
+
+  // allocates every level, halving the number of bins until one remains
+  for (std::size_t num = num_bins; 0 < num; num /= 2) {
+    levels_.push_back(std::vector<MinMaxBin2d>(num, bin_empty));
+    segments_.push_back(std::vector<Segment>());
+  }
+
+  // inserts each line into the finest level where it passes through a few
+  // bins
+  for (std::size_t i = 0; i < size; i++) {
+    // orders the points left to right
+    Segment segment;
+    segment.xa = x0[i];
+    segment.ya = y0[i];
+    segment.xb = x1[i];
+    segment.yb = y1[i];
+    if (segment.xb < segment.xa) {
+      std::swap(segment.xa, segment.xb);
+      std::swap(segment.ya, segment.yb);
+    }
+
+    const std::size_t index_a = IndexBin(segment.xa);
+    const std::size_t index_b = IndexBin(segment.xb);
+
+    std::size_t index_level = 0;
+    while (kNumBinsSegment
+           <= (index_b >> index_level) - (index_a >> index_level)) {
+      index_level++;
+    }
+
+    AddToLevel(segment, index_level);
+    if (index_level != 0) {
+      segments_[index_level].push_back(segment);
+    }
+  }
+
+  // sorts the kept lines so a query can search them by x value
+  for (auto iter = segments_.begin(); iter != segments_.end(); iter++) {
+    std::sort(iter->begin(), iter->end(),
+              [](const Segment& a, const Segment& b) { return a.xa < b.xa; });
+  }
+
+  // merges pairs of bins into the coarser levels
+  for (std::size_t index_level = 1; index_level < levels_.size();
+       index_level++) {
+    const std::vector<MinMaxBin2d>& level_fine = levels_[index_level - 1];
+    std::vector<MinMaxBin2d>& level_coarse = levels_[index_level];
+
+    for (std::size_t index = 0; index < level_coarse.size(); index++) {
+      MergeBin(level_fine[index * 2], level_coarse[index]);
+      MergeBin(level_fine[index * 2 + 1], level_coarse[index]);
+    }
+  }
+}
+
+void MinMaxPyramid2d::Clear() {
+  levels_.clear();
+  segments_.clear();
+
+  width_bin_ = 0;
+  x_max_ = -999999;
+  x_min_ = 999999;
+}
+
+std::size_t MinMaxPyramid2d::Query(const float& x_min, const float& x_max,
+                                   const int& num_columns,
+                                   std::vector<MinMaxBin2d>& columns) const {
+  MinMaxBin2d bin_empty;
+  bin_empty.count = 0;
+  bin_empty.y_max = -999999;
+  bin_empty.y_min = 999999;
+
+  columns.assign(std::max(num_columns, 0), bin_empty);
+
+  // checks if the pyramid and columns are valid
+  if ((levels_.empty() == true) || (num_columns <= 0)
+      || (width_bin_ <= 0) || (x_max <= x_min)) {
+    return 0;
+  }
+
+  // checks if the first level can resolve the columns
+  const float width_column = (x_max - x_min) / num_columns;
+  if (width_column < width_bin_ * kNumBinsColumn) {
+    return 0;
+  }
+
+  // checks if the range overlaps the lines
+  if ((x_max < x_min_) || (x_max_ < x_min)) {
+    return 0;
+  }
+
+  // selects the coarsest level with enough bins per column
+  std::size_t index_level = 0;
+  float width_level = width_bin_;
+  while ((index_level + 1 < levels_.size())
+         && (width_level * 2 * kNumBinsColumn <= width_column)) {
+    index_level++;
+    width_level *= 2;
+  }
+
+  const std::vector<MinMaxBin2d>& bins = levels_[index_level];
+
+  // merges the bins that overlap each column
+  std::size_t count = 0;
+  std::size_t index_bin_previous = bins.size();
+  for (int index = 0; index < num_columns; index++) {
+    const float xc0 = x_min + index * width_column;
+    const float xc1 = xc0 + width_column;
+    if ((xc1 < x_min_) || (x_max_ < xc0)) {
+      continue;
+    }
+
+    const std::size_t index_bin_0 = std::min(
+        static_cast<std::size_t>(std::max(xc0 - x_min_, 0.0f) / width_level),
+        bins.size() - 1);
+    const std::size_t index_bin_1 = std::min(
+        static_cast<std::size_t>(std::max(xc1 - x_min_, 0.0f) / width_level),
+        bins.size() - 1);
+
+    for (std::size_t index_bin = index_bin_0; index_bin <= index_bin_1;
+         index_bin++) {
+      MergeBin(bins[index_bin], columns[index]);
+
+      // counts each bin once, even if it is shared by adjacent columns
+      if (index_bin != index_bin_previous) {
+        count += bins[index_bin].count;
+        index_bin_previous = index_bin;
+      }
+    }
+  }
+
+  // interpolates the lines that were inserted into coarser levels directly
+  // into the columns, as their bins can be wider than a column
+  const float x_min_columns = std::max(x_min, x_min_);
+  const float x_max_columns = std::min(x_max, x_max_);
+  for (std::size_t index_level_segment = index_level + 1;
+       index_level_segment < segments_.size(); index_level_segment++) {
+    const std::vector<Segment>& segments = segments_[index_level_segment];
+
+    // a line within this level is shorter than the maximum number of bins,
+    // which limits how far left of the range it can start
+    const float width_segment = width_bin_ * (1u << index_level_segment)
+                                * kNumBinsSegment;
+
+    Segment segment_search;
+    segment_search.xa = x_min_columns - width_segment;
+    auto iter = std::lower_bound(
+        segments.cbegin(), segments.cend(), segment_search,
+        [](const Segment& a, const Segment& b) { return a.xa < b.xa; });
+
+    for (; (iter != segments.cend()) && (iter->xa <= x_max_columns); iter++) {
+      const Segment& segment = *iter;
+      if (segment.xb < x_min_columns) {
+        continue;
+      }
+
+      const float xa = std::max(segment.xa, x_min_columns);
+      const float xb = std::min(segment.xb, x_max_columns);
+      const int index_column_a = std::max(
+          static_cast<int>((xa - x_min) / width_column), 0);
+      const int index_column_b = std::min(
+          static_cast<int>((xb - x_min) / width_column), num_columns - 1);
+
+      const float slope = (segment.xb == segment.xa)
+                          ? 0 : (segment.yb - segment.ya)
+                                / (segment.xb - segment.xa);
+      for (int index = index_column_a; index <= index_column_b; index++) {
+        const float xc0 = std::max(segment.xa, x_min + index * width_column);
+        const float xc1 = std::min(segment.xb,
+                                   x_min + (index + 1) * width_column);
+
+        AddToBin(segment.ya + (xc0 - segment.xa) * slope,
+                 segment.ya + (xc1 - segment.xa) * slope, columns[index]);
+      }
+
+      count++;
+    }
+  }
+
+  return count;
+}
+
+void MinMaxPyramid2d::AddToLevel(const Segment& segment,
+                                 const std::size_t& index_level) {
+  std::vector<MinMaxBin2d>& bins = levels_[index_level];
+  const float width_level = width_bin_ * (1u << index_level);
+
+  const std::size_t index_a = IndexBin(segment.xa) >> index_level;
+  const std::size_t index_b = IndexBin(segment.xb) >> index_level;
+  if (index_a == index_b) {
+    AddToBin(segment.ya, segment.yb, bins[index_a]);
+    return;
+  }
+
+  // interpolates the y values at the bin boundaries
+  const float slope = (segment.yb - segment.ya) / (segment.xb - segment.xa);
+  for (std::size_t index = index_a; index <= index_b; index++) {
+    const float xc0 = std::max(segment.xa, x_min_ + index * width_level);
+    const float xc1 = std::min(segment.xb,
+                               x_min_ + (index + 1) * width_level);
+
+    AddToBin(segment.ya + (xc0 - segment.xa) * slope,
+             segment.ya + (xc1 - segment.xa) * slope, bins[index]);
+  }
+}
+
+void MinMaxPyramid2d::AddToBin(const float& ya, const float& yb,
+                               MinMaxBin2d& bin) {
+  bin.count++;
+  bin.y_min = std::min(bin.y_min, std::min(ya, yb));
+  bin.y_max = std::max(bin.y_max, std::max(ya, yb));
+}
+
+void MinMaxPyramid2d::MergeBin(const MinMaxBin2d& bin,
+                               MinMaxBin2d& bin_merged) {
+  if (bin.count == 0) {
+    return;
+  }
+
+  bin_merged.count += bin.count;
+  bin_merged.y_min = std::min(bin_merged.y_min, bin.y_min);
+  bin_merged.y_max = std::max(bin_merged.y_max, bin.y_max);
+}
+
+std::size_t MinMaxPyramid2d::IndexBin(const float& x) const {
+  const std::size_t num_bins = levels_.front().size();
+  if (width_bin_ <= 0) {
+    return 0;
+  }
+
+  const float index = (x - x_min_) / width_bin_;
+  if (index < 0) {
+    return 0;
+  } else if (num_bins <= index) {
+    return num_bins - 1;
+  } else {
+    return static_cast<std::size_t>(index);
+  }
+}
@@ -4,8 +4,28 @@
 #include "appcommon/graphics/plot_2d.h"
 
 #include <algorithm>
+#include <atomic>  // NOLINT
+#include <thread>  // NOLINT
+
+#include "wx/dcgraph.h"
+#include "wx/graphics.h"
 
 #include "appcommon/graphics/data_set_2d.h"
+#include "appcommon/graphics/svg_writer_2d.h"
+
+namespace {
+
+/// The width of the border that is rendered around each parallel render tile,
+/// in pixels. Text and markers are culled by their anchor point, so the border
+/// draws the parts that overlap the tile from anchors in the neighboring tiles.
+const int kSizeGutterParallel = 64;
+
+/// The width and height of a parallel render tile, in pixels. There are
+/// several tiles for each thread, which balances the load when the data is
+/// unevenly distributed across the plot.
+const int kSizeTileParallel = 256;
+
+}  // namespace
 
 Plot2d::Plot2d() {
   offset_.x = -999999;
@@ -22,6 +42,8 @@ Plot2d::Plot2d() {
 
   is_fitted_ = false;
   is_updated_limits_data_ = false;
+  is_updated_version_data_ = false;
+  version_data_ = 0;
 }
 
 Plot2d::~Plot2d() {
@@ -32,6 +54,7 @@ void Plot2d::AddRenderer(const Renderer2d* renderer) {
   renderers_.push_back(renderer);
 
   is_updated_limits_data_ = false;
+  is_updated_version_data_ = false;
 }
 
 void Plot2d::ClearRenderers() {
@@ -43,6 +66,127 @@ void Plot2d::ClearRenderers() {
   renderers_.clear();
 
   is_updated_limits_data_ = false;
+  is_updated_version_data_ = false;
+}
+
+Plot2d* Plot2d::Clone() const {
+  Plot2d* plot = new Plot2d();
+
+  // clones the renderers, which copy their styles
+  for (auto iter = renderers_.cbegin(); iter != renderers_.cend(); iter++) {
+    const Renderer2d* renderer = *iter;
+    const Renderer2d* clone = renderer->Clone();
+    if (clone == nullptr) {
+      delete plot;
+      return nullptr;
+    }
+
+    plot->AddRenderer(clone);
+  }
+
+  // copies the background, and modifies the copy so it does not share a
+  // reference count with the original
+  plot->brush_background_ = brush_background_;
+  if (brush_background_.IsOk() == true) {
+    plot->brush_background_.SetColour(brush_background_.GetColour());
+  }
+
+  // copies the transform
+  // the clone is not fitted, as fitting would read the dataset limits
+  plot->offset_ = offset_;
+  plot->scale_ = scale_;
+  plot->scale_x_ = scale_x_;
+  plot->scale_y_ = scale_y_;
+  plot->zoom_factor_fitted_ = zoom_factor_fitted_;
+
+  return plot;
+}
+
+wxDC* Plot2d::CreateDcImage(wxImage& image, const wxColour& background) {
+  wxGraphicsContext* context = wxGraphicsContext::Create(image);
+  if (context == nullptr) {
+    return nullptr;
+  }
+
+  wxGCDC* dc = new wxGCDC(context);
+
+  // replaces the default styles with new objects built from plain values
+  dc->SetBackgroundMode(wxSOLID);
+  dc->SetBackground(wxBrush(wxColour(background.Red(), background.Green(),
+                                     background.Blue(), background.Alpha())));
+  dc->SetBrush(wxBrush(wxColour(255, 255, 255)));
+  dc->SetPen(wxPen(wxColour(0, 0, 0)));
+  dc->SetTextBackground(wxColour(255, 255, 255));
+  dc->SetTextForeground(wxColour(0, 0, 0));
+
+  // modifying the font copy gives it a separate reference count
+  wxFont font(*wxNORMAL_FONT);
+  font.SetPointSize(font.GetPointSize());
+  dc->SetFont(font);
+
+  return dc;
+}
+
+bool Plot2d::ExportSvg(const std::string& filename, const int& width,
+                       const int& height) const {
+  // checks if the size is valid
+  if ((width <= 0) || (height <= 0)) {
+    return false;
+  }
+
+  // creates the file and fills the background
+  SvgWriter2d writer;
+  if (writer.Open(filename, width, height,
+                  brush_background_.GetColour()) == false) {
+    return false;
+  }
+
+  if (renderers_.empty() == false) {
+    // fits plot data to the drawing size
+    const wxRect rc(0, 0, width, height);
+    FitToRect(rc);
+
+    // generates plot render axes
+    const Plot2dTransform transform = Transform();
+    const PlotAxis axis_horizontal = Axis(rc.GetPosition().x, rc.GetWidth(),
+                                          false, transform);
+    const PlotAxis axis_vertical = Axis(rc.GetPosition().y, rc.GetHeight(),
+                                        true, transform);
+
+    // the memory dc is never drawn onto, and only supplies the background
+    // and the font to measure text with
+    wxMemoryDC dc;
+    dc.SetBackground(brush_background_);
+
+    // writes all renderers
+    for (auto iter = renderers_.cbegin(); iter != renderers_.cend(); iter++) {
+      const Renderer2d* renderer = *iter;
+      renderer->Export(dc, writer, rc, axis_horizontal, axis_vertical);
+    }
+  }
+
+  return writer.Close();
+}
+
+void Plot2d::FitToRect(const wxRect& rc) const {
+  // exits if fitting is disabled or no renderers are present
+  if ((is_fitted_ == false) || (renderers_.empty() == true)) {
+    return;
+  }
+
+  // updates plot data limits
+  if (IsUpdatedDataLimits() == false) {
+    UpdateDataLimits();
+  }
+
+  // updates the offset and scale
+  UpdateOffsetAndScaleToFitData(rc);
+
+  // applies zoom adjustment at center of graphics rect
+  wxPoint point_zoom;
+  point_zoom.x = rc.GetPosition().x + (rc.GetWidth() / 2);
+  point_zoom.y = rc.GetPosition().y + (rc.GetHeight() / 2);
+  DoZoom(zoom_factor_fitted_, point_zoom);
 }
 
 bool Plot2d::HasRenderers() const {
@@ -55,13 +199,45 @@ bool Plot2d::HasRenderers() const {
 
 Plot2dDataLimits Plot2d::LimitsData() const {
   // updates plot data limits
-  if (is_updated_limits_data_ == false) {
+  if (IsUpdatedDataLimits() == false) {
     UpdateDataLimits();
   }
 
   return limits_data_;
 }
 
+bool Plot2d::Pick(const wxPoint& point, const float& radius,
+                  Plot2dPick& pick) const {
+  // converts the point to data coordinates
+  const Point2d<float> point_data = PointGraphicsToData(point);
+  const float scale_x = scale_ * scale_x_;
+  const float scale_y = scale_ * scale_y_;
+
+  // searches each dataset, shrinking the radius to the nearest element found
+  // so far
+  bool is_found = false;
+  float radius_search = radius;
+  for (auto iter = renderers_.cbegin(); iter != renderers_.cend(); iter++) {
+    const Renderer2d* renderer = *iter;
+    const DataSet2d* dataset = renderer->dataset();
+
+    unsigned int index = 0;
+    float distance = 0;
+    if (dataset->Nearest(point_data, scale_x, scale_y, radius_search, index,
+                         distance) == true) {
+      pick.dataset = dataset;
+      pick.distance = distance;
+      pick.index = index;
+      pick.renderer = renderer;
+
+      radius_search = distance;
+      is_found = true;
+    }
+  }
+
+  return is_found;
+}
+
 wxPoint Plot2d::PointDataToGraphics(const Point2d<float>& point_data) const {
   // applies offset and scale
   wxPoint point;
@@ -83,6 +259,13 @@ Point2d<float> Plot2d::PointGraphicsToData(
   return point;
 }
 
+void Plot2d::Prepare() const {
+  for (auto iter = renderers_.cbegin(); iter != renderers_.cend(); iter++) {
+    const Renderer2d* renderer = *iter;
+    renderer->dataset()->Prepare();
+  }
+}
+
 void Plot2d::Render(wxDC& dc, wxRect rc) const {
   // sets background color and clears
   dc.SetBackgroundMode(wxSOLID);
@@ -95,33 +278,316 @@ void Plot2d::Render(wxDC& dc, wxRect rc) const {
   }
 
   // fits plot data to graphics rect
-  if (is_fitted_ == true) {
-    // updates plot data limits
-    if (is_updated_limits_data_ == false) {
-      UpdateDataLimits();
+  FitToRect(rc);
+
+  // triggers all renderers
+  RenderTransformed(dc, rc, Transform(), nullptr);
+}
+
+bool Plot2d::RenderAxes(wxDC& dc, const wxRect& rc,
+                        const PlotAxis& axis_horizontal,
+                        const PlotAxis& axis_vertical,
+                        const std::atomic<bool>* is_cancelled) const {
+  // triggers all renderers
+  for (auto iter = renderers_.cbegin(); iter != renderers_.cend(); iter++) {
+    // checks if the render has been cancelled
+    if ((is_cancelled != nullptr) && (is_cancelled->load() == true)) {
+      return false;
+    }
+
+    const Renderer2d* renderer = *iter;
+    renderer->Render(dc, rc, axis_horizontal, axis_vertical);
+  }
+
+  return true;
+}
+
+void Plot2d::RenderParallel(wxDC& dc, wxRect rc,
+                            const int& num_threads) const {
+  // sets background color and clears
+  dc.SetBackgroundMode(wxSOLID);
+  dc.SetBackground(brush_background_);
+  dc.Clear();
+
+  // exits if no renderers are present
+  if (renderers_.empty() == true) {
+    return;
+  }
+
+  // fits plot data to graphics rect
+  FitToRect(rc);
+  const Plot2dTransform transform = Transform();
+
+  // splits the graphics rect into tiles
+  std::vector<wxRect> tiles;
+  const int kRight = rc.GetX() + rc.GetWidth();
+  const int kBottom = rc.GetY() + rc.GetHeight();
+  for (int y = rc.GetY(); y < kBottom; y += kSizeTileParallel) {
+    for (int x = rc.GetX(); x < kRight; x += kSizeTileParallel) {
+      tiles.push_back(wxRect(x, y, std::min(kSizeTileParallel, kRight - x),
+                             std::min(kSizeTileParallel, kBottom - y)));
+    }
+  }
+
+  // solves for the number of threads
+  int num_workers = num_threads;
+  if (num_workers <= 0) {
+    num_workers = static_cast<int>(std::thread::hardware_concurrency());
+  }
+  num_workers = std::min(num_workers, static_cast<int>(tiles.size()));
+
+  // renders serially if there is only one thread
+  if (num_workers <= 1) {
+    RenderTransformed(dc, rc, transform, nullptr);
+    return;
+  }
+
+  // clones the renderers for each thread
+  // this is done on the calling thread, which owns the renderer styles
+  std::vector<std::vector<Renderer2d*>> clones(num_workers);
+  bool is_cloned = true;
+  for (auto iter_clones = clones.begin(); iter_clones != clones.end();
+       iter_clones++) {
+    for (auto iter = renderers_.cbegin(); iter != renderers_.cend(); iter++) {
+      const Renderer2d* renderer = *iter;
+      Renderer2d* clone = renderer->Clone();
+      if (clone == nullptr) {
+        is_cloned = false;
+        break;
+      }
+
+      // each clone draws separate tiles, so caching would not be reused
+      clone->set_is_cached(false);
+      iter_clones->push_back(clone);
+    }
+  }
+
+  if (is_cloned == false) {
+    // renders serially, as a renderer does not support cloning
+    RenderTransformed(dc, rc, transform, nullptr);
+  } else {
+    // prepares the datasets for concurrent reads
+    Prepare();
+
+    // creates an image and device context for each tile, with a border on
+    // each side
+    // this is done on the calling thread, as a new device context copies the
+    // stock styles, and the images are sized up front so their addresses do
+    // not change while the device contexts draw into them
+    wxColour background(255, 255, 255);
+    if (brush_background_.IsOk() == true) {
+      background = brush_background_.GetColour();
+    }
+
+    std::vector<wxImage> images(tiles.size());
+    std::vector<wxDC*> dcs(tiles.size(), nullptr);
+    for (std::size_t i = 0; i < tiles.size(); i++) {
+      const wxRect& tile = tiles[i];
+      images[i].Create(tile.GetWidth() + 2 * kSizeGutterParallel,
+                       tile.GetHeight() + 2 * kSizeGutterParallel);
+      dcs[i] = CreateDcImage(images[i], background);
+    }
+
+    // renders tiles until none remain
+    std::atomic<std::size_t> index_next(0);
+    auto render_tiles = [&](const int& index_worker) {
+      while (true) {
+        const std::size_t index = index_next.fetch_add(1);
+        if (tiles.size() <= index) {
+          return;
+        }
+
+        wxDC* dc_tile = dcs[index];
+        if (dc_tile == nullptr) {
+          continue;
+        }
+
+        dc_tile->Clear();
+
+        const wxRect& tile = tiles[index];
+        const wxRect rc_tile(0, 0,
+                             tile.GetWidth() + 2 * kSizeGutterParallel,
+                             tile.GetHeight() + 2 * kSizeGutterParallel);
+        const PlotAxis axis_horizontal = Axis(
+            tile.GetX() - kSizeGutterParallel, rc_tile.GetWidth(), false,
+            transform);
+        const PlotAxis axis_vertical = Axis(
+            tile.GetY() - kSizeGutterParallel, rc_tile.GetHeight(), true,
+            transform);
+
+        const std::vector<Renderer2d*>& renderers = clones[index_worker];
+        for (auto iter = renderers.cbegin(); iter != renderers.cend();
+             iter++) {
+          const Renderer2d* renderer = *iter;
+          renderer->Render(*dc_tile, rc_tile, axis_horizontal,
+                           axis_vertical);
+        }
+      }
+    };
+
+    // starts the other threads and renders on the calling thread as well
+    std::vector<std::thread> threads;
+    for (int i = 1; i < num_workers; i++) {
+      threads.push_back(std::thread(render_tiles, i));
+    }
+
+    render_tiles(0);
+
+    for (auto iter = threads.begin(); iter != threads.end(); iter++) {
+      iter->join();
+    }
+
+    // draws the tile images, keeping each tile within its border
+    // the images are only updated once the device contexts are deleted
+    for (std::size_t i = 0; i < tiles.size(); i++) {
+      if (dcs[i] == nullptr) {
+        continue;
+      }
+
+      delete dcs[i];
+
+      const wxRect& tile = tiles[i];
+      const wxImage image = images[i].GetSubImage(
+          wxRect(kSizeGutterParallel, kSizeGutterParallel, tile.GetWidth(),
+                 tile.GetHeight()));
+      dc.DrawBitmap(wxBitmap(image), tile.GetX(), tile.GetY());
+    }
+  }
+
+  // deletes the clones
+  for (auto iter_clones = clones.begin(); iter_clones != clones.end();
+       iter_clones++) {
+    for (auto iter = iter_clones->begin(); iter != iter_clones->end();
+         iter++) {
+      delete *iter;
+    }
+  }
+}
+
+wxImage Plot2d::RenderToImage(const int& width, const int& height) const {
+  // checks if the size is valid
+  if ((width <= 0) || (height <= 0)) {
+    return wxImage();
+  }
+
+  // creates a device context that draws into the image
+  wxColour background(255, 255, 255);
+  if (brush_background_.IsOk() == true) {
+    background = brush_background_.GetColour();
+  }
+
+  wxImage image(width, height);
+  wxDC* dc = CreateDcImage(image, background);
+  if (dc == nullptr) {
+    return wxImage();
+  }
+
+  // renders
+  // the image is only updated once the device context is deleted
+  Render(*dc, wxRect(0, 0, width, height));
+  delete dc;
+
+  return image;
+}
+
+std::vector<wxImage> Plot2d::RenderToImages(
+    const std::vector<const Plot2d*>& plots, const int& width,
+    const int& height, const int& num_threads) {
+  std::vector<wxImage> images(plots.size());
+
+  // checks if the size is valid
+  if ((width <= 0) || (height <= 0)) {
+    return images;
+  }
+
+  // fits and clones each plot, and creates its device context
+  // this is done on the calling thread, which owns the renderer styles, and
+  // the images are sized up front so their addresses do not change while the
+  // device contexts draw into them
+  const wxRect rc(0, 0, width, height);
+  std::vector<Plot2d*> clones(plots.size(), nullptr);
+  std::vector<wxDC*> dcs(plots.size(), nullptr);
+  for (std::size_t i = 0; i < plots.size(); i++) {
+    const Plot2d* plot = plots[i];
+    plot->FitToRect(rc);
+    plot->Prepare();
+
+    // renders on this thread if the plot cannot be cloned
+    clones[i] = plot->Clone();
+    if (clones[i] == nullptr) {
+      images[i] = plot->RenderToImage(width, height);
+      continue;
+    }
+
+    wxColour background(255, 255, 255);
+    if (plot->brush_background_.IsOk() == true) {
+      background = plot->brush_background_.GetColour();
+    }
+
+    images[i].Create(width, height);
+    dcs[i] = CreateDcImage(images[i], background);
+  }
+
+  // solves for the number of threads
+  int num_workers = num_threads;
+  if (num_workers <= 0) {
+    num_workers = static_cast<int>(std::thread::hardware_concurrency());
+  }
+  num_workers = std::max(std::min(num_workers,
+                                  static_cast<int>(plots.size())), 1);
+
+  // renders plots until none remain
+  std::atomic<std::size_t> index_next(0);
+  auto render_plots = [&]() {
+    while (true) {
+      const std::size_t index = index_next.fetch_add(1);
+      if (plots.size() <= index) {
+        return;
+      }
+
+      if (dcs[index] == nullptr) {
+        continue;
+      }
+
+      clones[index]->Render(*dcs[index], rc);
     }
+  };
+
+  // starts the other threads and renders on the calling thread as well
+  std::vector<std::thread> threads;
+  for (int i = 1; i < num_workers; i++) {
+    threads.push_back(std::thread(render_plots));
+  }
 
-    // updates the offset and scale
-    UpdateOffsetAndScaleToFitData(rc);
+  render_plots();
 
-    // applies zoom adjustment at center of graphics rect
-    wxPoint point_zoom;
-    point_zoom.x = rc.GetPosition().x + (rc.GetWidth() / 2);
-    point_zoom.y = rc.GetPosition().y + (rc.GetHeight() / 2);
-    DoZoom(zoom_factor_fitted_, point_zoom);
+  for (auto iter = threads.begin(); iter != threads.end(); iter++) {
+    iter->join();
   }
 
+  // deletes the device contexts, which updates the images, and the clones
+  for (std::size_t i = 0; i < plots.size(); i++) {
+    if ((clones[i] != nullptr) && (dcs[i] == nullptr)) {
+      images[i] = wxImage();
+    }
+
+    delete dcs[i];
+    delete clones[i];
+  }
+
+  return images;
+}
+
+bool Plot2d::RenderTransformed(wxDC& dc, const wxRect& rc,
+                               const Plot2dTransform& transform,
+                               const std::atomic<bool>* is_cancelled) const {
   // generates plot render axes
   const PlotAxis axis_horizontal = Axis(rc.GetPosition().x, rc.GetWidth(),
-                                        false);
+                                        false, transform);
   const PlotAxis axis_vertical = Axis(rc.GetPosition().y, rc.GetHeight(),
-                                      true);
+                                      true, transform);
 
-  // triggers all renderers
-  for (auto iter = renderers_.cbegin(); iter != renderers_.cend(); iter++) {
-    const Renderer2d* renderer = *iter;
-    renderer->Draw(dc, rc, axis_horizontal, axis_vertical);
-  }
+  return RenderAxes(dc, rc, axis_horizontal, axis_vertical, is_cancelled);
 }
 
 void Plot2d::Shift(const int& x, const int& y) {
@@ -134,6 +600,59 @@ void Plot2d::Shift(const int& x, const int& y) {
   offset_.y += kShiftY;
 }
 
+std::vector<Renderer2dStatistics> Plot2d::Statistics() const {
+  std::vector<Renderer2dStatistics> statistics;
+  statistics.reserve(renderers_.size());
+  for (auto iter = renderers_.cbegin(); iter != renderers_.cend(); iter++) {
+    const Renderer2d* renderer = *iter;
+    statistics.push_back(renderer->statistics());
+  }
+
+  return statistics;
+}
+
+Plot2dTransform Plot2d::Transform() const {
+  Plot2dTransform transform;
+  transform.offset = offset_;
+  transform.scale = scale_;
+  transform.scale_x = scale_x_;
+  transform.scale_y = scale_y_;
+
+  return transform;
+}
+
+uint64_t Plot2d::VersionData() const {
+  // checks if the renderers or any dataset changed since the last check
+  bool is_modified = !is_updated_version_data_;
+  if (is_modified == false) {
+    auto iter_version = versions_data_.cbegin();
+    for (auto iter = renderers_.cbegin(); iter != renderers_.cend(); iter++) {
+      const Renderer2d* renderer = *iter;
+      if ((iter_version == versions_data_.cend())
+          || (renderer->dataset()->version() != *iter_version)) {
+        is_modified = true;
+        break;
+      }
+
+      iter_version++;
+    }
+  }
+
+  // updates the version and the cached dataset versions
+  if (is_modified == true) {
+    versions_data_.clear();
+    for (auto iter = renderers_.cbegin(); iter != renderers_.cend(); iter++) {
+      const Renderer2d* renderer = *iter;
+      versions_data_.push_back(renderer->dataset()->version());
+    }
+
+    version_data_++;
+    is_updated_version_data_ = true;
+  }
+
+  return version_data_;
+}
+
 void Plot2d::Zoom(const float& factor, const wxPoint& point) {
   DoZoom(factor, point);
 
@@ -198,7 +717,8 @@ float Plot2d::zoom_factor_fitted() const {
 }
 
 PlotAxis Plot2d::Axis(const int& position, const int& range,
-                      const bool& is_vertical) const {
+                      const bool& is_vertical,
+                      const Plot2dTransform& transform) {
   // initializes axis
   PlotAxis axis;
 
@@ -209,22 +729,24 @@ PlotAxis Plot2d::Axis(const int& position, const int& range,
     // solves for center graphics position and converts to data coordinates
     float center = static_cast<float>(position)
                    + (static_cast<float>(range) / 2);
-    center = offset_.y - (center / (scale_ * scale_y_));
+    center = transform.offset.y
+             - (center / (transform.scale * transform.scale_y));
     axis.set_position_center(center);
 
     // solves for data range
-    axis.set_range(range / (scale_ * scale_y_));
+    axis.set_range(range / (transform.scale * transform.scale_y));
   } else {
     axis = PlotAxis(PlotAxis::OrientationType::kHorizontal);
 
     // solves for center graphics position and converts to data coordiantes
     float center = static_cast<float>(position)
                    + (static_cast<float>(range) / 2);
-    center = offset_.x + (center / (scale_ * scale_x_));
+    center = transform.offset.x
+             + (center / (transform.scale * transform.scale_x));
     axis.set_position_center(center);
 
     // solves for data range
-    axis.set_range(range / (scale_ * scale_x_));
+    axis.set_range(range / (transform.scale * transform.scale_x));
   }
 
   return axis;
@@ -245,6 +767,26 @@ void Plot2d::DoZoom(const float& factor, const wxPoint& point) const {
   offset_.y -= (point_new.y - point_old.y);
 }
 
+bool Plot2d::IsUpdatedDataLimits() const {
+  if (is_updated_limits_data_ == false) {
+    return false;
+  }
+
+  // compares the dataset versions to the cached versions
+  auto iter_version = versions_datasets_.cbegin();
+  for (auto iter = renderers_.cbegin(); iter != renderers_.cend(); iter++) {
+    const Renderer2d* renderer = *iter;
+    if ((iter_version == versions_datasets_.cend())
+        || (renderer->dataset()->version() != *iter_version)) {
+      return false;
+    }
+
+    iter_version++;
+  }
+
+  return true;
+}
+
 /// This method compares the aspect ratio (height/width) of the data and the
 /// graphics rect to solve for offset and scaling.
 void Plot2d::UpdateOffsetAndScaleToFitData(const wxRect& rc) const {
@@ -304,9 +846,12 @@ void Plot2d::UpdateDataLimits() const {
   float x_max = -999999;
   float y_min = 999999;
   float y_max = -999999;
+  versions_datasets_.clear();
   for (auto iter = renderers_.cbegin(); iter != renderers_.cend(); iter++) {
     const Renderer2d* renderer = *iter;
     const DataSet2d* dataset = renderer->dataset();
+    versions_datasets_.push_back(dataset->version());
+
     x_min = std::min(x_min, dataset->MinX());
     x_max = std::max(x_max, dataset->MaxX());
 
@@ -3,9 +3,39 @@
 
 #include "appcommon/graphics/plot_pane_2d.h"
 
+#include <algorithm>
+#include <chrono>  // NOLINT
+#include <cmath>
+#include <cstdlib>
+
 #include "models/transmissionline/catenary.h"
 #include "wx/dcbuffer.h"
 
+namespace {
+
+/// The width of the border that is rendered around each exposed strip of the
+/// cached bitmap, in pixels. Text and markers are culled by their anchor
+/// point, so the border draws the parts that overlap the strip from anchors
+/// outside of it.
+const int kSizeGutterStrip = 64;
+
+/// \brief Gets if two plot transforms are equal.
+/// \param[in] transform_a
+///   The first transform.
+/// \param[in] transform_b
+///   The second transform.
+/// \return If the transforms are equal.
+bool IsEqual(const Plot2dTransform& transform_a,
+             const Plot2dTransform& transform_b) {
+  return (transform_a.offset.x == transform_b.offset.x)
+      && (transform_a.offset.y == transform_b.offset.y)
+      && (transform_a.scale == transform_b.scale)
+      && (transform_a.scale_x == transform_b.scale_x)
+      && (transform_a.scale_y == transform_b.scale_y);
+}
+
+}  // namespace
+
 BEGIN_EVENT_TABLE(PlotPane2d, wxPanel)
   EVT_ENTER_WINDOW(PlotPane2d::OnMouse)
   EVT_ERASE_BACKGROUND(PlotPane2d::OnEraseBackground)
@@ -20,7 +50,8 @@ END_EVENT_TABLE()
 
 PlotPane2d::PlotPane2d(wxWindow* parent)
     : wxPanel(parent, wxID_ANY, wxDefaultPosition, wxDefaultSize,
-              wxTAB_TRAVERSAL) {
+              wxTAB_TRAVERSAL),
+      timer_frame_(this, wxWindow::NewControlId()) {
   // initializes mouse coordinate
   coord_mouse_.x = -9999;
   coord_mouse_.y = -9999;
@@ -34,23 +65,193 @@ PlotPane2d::PlotPane2d(wxWindow* parent)
   plot_.set_scale_y(1);
   plot_.set_zoom_factor_fitted(1);
 
+  // initializes cache
+  is_cached_ = false;
+  is_shifted_cache_ = false;
+  is_updated_cache_ = false;
+  scale_cache_ = 0;
+  scale_x_cache_ = 0;
+  scale_y_cache_ = 0;
+  version_cache_ = 0;
+
+  // initializes parallel rendering
+  num_threads_ = 1;
+
+  // initializes tiling
+  is_tiled_ = false;
+
+  // initializes asynchronous rendering
+  // the frame event uses a reserved id, so it does not collide with events
+  // from derived classes
+  id_event_frame_ = wxWindow::NewControlId();
+  Bind(wxEVT_THREAD, &PlotPane2d::OnThreadFrame, this, id_event_frame_);
+  count_update_ = 0;
+  id_frame_ = 0;
+  is_async_ = false;
+  is_requested_ = false;
+  version_request_ = 0;
+  worker_ = nullptr;
+
+  // initializes frame scheduling
+  // the timer uses a reserved id, so it does not collide with the ids of
+  // derived classes
+  Bind(wxEVT_TIMER, &PlotPane2d::OnTimerFrame, this, timer_frame_.GetId());
+  budget_frame_ = 16;
+  duration_paint_ = 0;
+  is_scheduled_ = false;
+
+  // initializes overlay
+  is_updated_base_ = false;
+
+  // initializes diagnostics
+  diagnostics_.duration_frame = 0;
+  is_instrumented_ = false;
+
   // setting to avoid flickering
   this->SetBackgroundStyle(wxBG_STYLE_PAINT);
 }
 
 PlotPane2d::~PlotPane2d() {
+  timer_frame_.Stop();
+
+  // stops the worker thread before the plot is destroyed
+  delete worker_;
+
+  wxWindow::UnreserveControlId(id_event_frame_);
+  wxWindow::UnreserveControlId(timer_frame_.GetId());
+}
+
+void PlotPane2d::BeginUpdate() {
+  // stops the worker from reading the datasets before they are modified
+  if (count_update_ == 0) {
+    CancelRender();
+  }
+
+  count_update_++;
+}
+
+void PlotPane2d::CancelRender() {
+  if (worker_ != nullptr) {
+    worker_->Cancel();
+  }
+
+  is_requested_ = false;
+}
+
+void PlotPane2d::EndUpdate() {
+  if (count_update_ <= 0) {
+    return;
+  }
+
+  count_update_--;
+
+  // draws the modified datasets
+  if (count_update_ == 0) {
+    Refresh();
+  }
+}
+
+void PlotPane2d::InvalidateCache() {
+  is_updated_base_ = false;
+  is_updated_cache_ = false;
+  tiles_.Clear();
+}
+
+void PlotPane2d::Refresh(bool erase_background, const wxRect* rect) {
+  // any refresh besides the overlay and scheduled frames may change what the
+  // renderers draw, which the caches do not track
+  InvalidateCache();
+  is_requested_ = false;
+
+  wxPanel::Refresh(erase_background, rect);
+}
+
+void PlotPane2d::RefreshOverlay(const wxRect& rect) {
+  // bypasses Refresh() so the base frame stays valid
+  wxPanel::Refresh(false, &rect);
 }
 
 void PlotPane2d::RenderPlot(wxDC& dc) {
+  const wxRect rc = GetClientRect();
+
+  // starts timing the frame if instrumented
+  std::chrono::steady_clock::time_point time_start;
+  if (is_instrumented_ == true) {
+    time_start = std::chrono::steady_clock::now();
+  }
+
   RenderBefore(dc);
-  plot_.Render(dc, GetClientRect());
+
+  if (is_async_ == true) {
+    RenderAsync(dc, rc);
+  } else if (is_tiled_ == true) {
+    tiles_.Render(plot_, dc, rc);
+  } else if (is_cached_ == true) {
+    // updates the cached bitmap and copies it to the device context
+    UpdateCache(rc);
+
+    wxMemoryDC dc_cache(bitmap_cache_);
+    dc.Blit(rc.GetX(), rc.GetY(), rc.GetWidth(), rc.GetHeight(), &dc_cache,
+            0, 0);
+  } else {
+    plot_.RenderParallel(dc, rc, num_threads_);
+  }
+
   RenderAfter(dc);
+
+  // updates and draws the diagnostics
+  if (is_instrumented_ == true) {
+    const std::chrono::duration<double, std::milli> duration =
+        std::chrono::steady_clock::now() - time_start;
+    diagnostics_.duration_frame = duration.count();
+
+    // the worker owns the renderer statistics while rendering asynchronously
+    if (is_async_ == true) {
+      diagnostics_.renderers = worker_->Statistics();
+    } else {
+      diagnostics_.renderers = plot_.Statistics();
+    }
+
+    RenderDiagnostics(dc);
+  }
 }
 
 wxBrush PlotPane2d::background() const {
   return plot_.background();
 }
 
+int PlotPane2d::budget_frame() const {
+  return budget_frame_;
+}
+
+std::size_t PlotPane2d::budget_tiles() const {
+  return tiles_.budget_memory();
+}
+
+const PlotPane2dDiagnostics& PlotPane2d::diagnostics() const {
+  return diagnostics_;
+}
+
+bool PlotPane2d::is_async() const {
+  return is_async_;
+}
+
+bool PlotPane2d::is_cached() const {
+  return is_cached_;
+}
+
+bool PlotPane2d::is_instrumented() const {
+  return is_instrumented_;
+}
+
+bool PlotPane2d::is_tiled() const {
+  return is_tiled_;
+}
+
+int PlotPane2d::num_threads() const {
+  return num_threads_;
+}
+
 const Plot2d* PlotPane2d::plot() const {
   return &plot_;
 }
@@ -59,6 +260,71 @@ void PlotPane2d::set_background(const wxBrush& brush) {
   plot_.set_background(brush);
 }
 
+void PlotPane2d::set_budget_frame(const int& budget_frame) {
+  budget_frame_ = std::max(budget_frame, 0);
+}
+
+void PlotPane2d::set_budget_tiles(const std::size_t& budget_tiles) {
+  tiles_.set_budget_memory(budget_tiles);
+}
+
+void PlotPane2d::set_is_async(const bool& is_async) {
+  if (is_async_ == is_async) {
+    return;
+  }
+
+  is_async_ = is_async;
+
+  // starts or stops the worker thread
+  if (is_async_ == true) {
+    worker_ = new PlotRenderWorker2d(this, id_event_frame_);
+  } else {
+    delete worker_;
+    worker_ = nullptr;
+
+    bitmap_frame_ = wxBitmap();
+  }
+
+  id_frame_ = 0;
+  is_requested_ = false;
+}
+
+void PlotPane2d::set_is_cached(const bool& is_cached) {
+  is_cached_ = is_cached;
+
+  // releases the cached bitmap when disabled
+  if (is_cached_ == false) {
+    bitmap_cache_ = wxBitmap();
+  }
+
+  is_updated_cache_ = false;
+}
+
+void PlotPane2d::set_is_instrumented(const bool& is_instrumented) {
+  is_instrumented_ = is_instrumented;
+
+  // releases the diagnostics when disabled
+  if (is_instrumented_ == false) {
+    diagnostics_.duration_frame = 0;
+    diagnostics_.renderers.clear();
+  }
+
+  this->Refresh();
+}
+
+void PlotPane2d::set_is_tiled(const bool& is_tiled) {
+  is_tiled_ = is_tiled;
+
+  // releases the tiles when disabled
+  if (is_tiled_ == false) {
+    tiles_.Clear();
+  }
+}
+
+void PlotPane2d::set_num_threads(const int& num_threads) {
+  num_threads_ = num_threads;
+}
+
 /// This function overrides the typical window erase background event handling.
 /// When used in conjuction with double-buffered device contexts, it will
 /// prevent flickering.
@@ -98,8 +364,8 @@ void PlotPane2d::OnMouse(wxMouseEvent& event) {
     // updates cached mouse point
     coord_mouse_ = coord_new;
 
-    // refreshes window
-    this->Refresh();
+    // schedules a repaint
+    ScheduleFrame();
   } else if (event.Leaving() == true) {
     // resets mouse coordinates
     coord_mouse_.x = -9999;
@@ -112,6 +378,12 @@ void PlotPane2d::OnMouse(wxMouseEvent& event) {
     coord_mouse_.x = event.GetX();
     coord_mouse_.y = event.GetY();
   } else if (event.LeftUp() == true) {
+    // re-renders the cache after a drag, which removes any rounding error
+    // from shifting the cached bitmap
+    if (is_shifted_cache_ == true) {
+      this->Refresh();
+    }
+
     // resets mouse coordinates
     coord_mouse_.x = -9999;
     coord_mouse_.y = -9999;
@@ -154,8 +426,8 @@ void PlotPane2d::OnMouseWheel(wxMouseEvent& event) {
     plot_.Zoom(kZoomFactor, coord_zoom);
   }
 
-  // refreshes window
-  this->Refresh();
+  // schedules a repaint
+  ScheduleFrame();
 }
 
 void PlotPane2d::OnPaint(wxPaintEvent& event) {
@@ -163,8 +435,63 @@ void PlotPane2d::OnPaint(wxPaintEvent& event) {
   // a buffered device context helps prevent flickering
   wxBufferedPaintDC dc(this, bitmap_buffer_);
 
-  // renders
-  RenderPlot(dc);
+  // clears the scheduled repaint, as any pending zooms and pans are drawn now
+  is_scheduled_ = false;
+
+  time_paint_ = std::chrono::steady_clock::now();
+
+  // checks if the pane has an area to draw onto
+  const wxSize size = GetClientSize();
+  if ((size.GetWidth() <= 0) || (size.GetHeight() <= 0)) {
+    return;
+  }
+
+  // renders the base frame if it is outdated
+  if ((is_updated_base_ == false) || (bitmap_base_.IsOk() == false)
+      || (bitmap_base_.GetSize() != size)) {
+    if ((bitmap_base_.IsOk() == false) || (bitmap_base_.GetSize() != size)) {
+      bitmap_base_ = wxBitmap(size.GetWidth(), size.GetHeight());
+    }
+
+    wxMemoryDC dc_base(bitmap_base_);
+    RenderPlot(dc_base);
+    is_updated_base_ = true;
+  }
+
+  // copies the refreshed rectangle from the base frame
+  const wxRect rect = GetUpdateRegion().GetBox();
+  {
+    wxMemoryDC dc_base;
+    dc_base.SelectObjectAsSource(bitmap_base_);
+    dc.Blit(rect.GetX(), rect.GetY(), rect.GetWidth(), rect.GetHeight(),
+            &dc_base, rect.GetX(), rect.GetY());
+  }
+
+  // draws the overlay within the refreshed rectangle
+  dc.SetClippingRegion(rect);
+  RenderOverlay(dc);
+  dc.DestroyClippingRegion();
+
+  // measures the duration
+  const std::chrono::duration<double, std::milli> duration =
+      std::chrono::steady_clock::now() - time_paint_;
+  duration_paint_ = duration.count();
+}
+
+void PlotPane2d::OnThreadFrame(wxThreadEvent& event) {
+  RefreshFrame();
+}
+
+void PlotPane2d::OnTimerFrame(wxTimerEvent& event) {
+  is_scheduled_ = true;
+  RefreshFrame();
+}
+
+void PlotPane2d::RefreshFrame() {
+  // bypasses Refresh() so the cached bitmap and tiles stay valid
+  is_updated_base_ = false;
+
+  wxPanel::Refresh();
 }
 
 void PlotPane2d::RenderAfter(wxDC& dc) {
@@ -174,3 +501,262 @@ void PlotPane2d::RenderAfter(wxDC& dc) {
 void PlotPane2d::RenderBefore(wxDC& dc) {
   // placeholder for optional override
 }
+
+void PlotPane2d::RenderOverlay(wxDC& dc) {
+  // placeholder for optional override
+}
+
+void PlotPane2d::RenderDiagnostics(wxDC& dc) {
+  // generates the text lines
+  std::vector<wxString> lines;
+  lines.push_back(wxString::Format("frame: %.2f ms",
+                                   diagnostics_.duration_frame));
+
+  for (std::size_t i = 0; i < diagnostics_.renderers.size(); i++) {
+    const Renderer2dStatistics& statistics = diagnostics_.renderers[i];
+    lines.push_back(wxString::Format(
+        "renderer %d: %.2f ms, %d considered, %d culled, %d drawn",
+        static_cast<int>(i), statistics.duration,
+        static_cast<int>(statistics.count_total),
+        static_cast<int>(statistics.count_total - statistics.count_drawn),
+        static_cast<int>(statistics.count_drawn)));
+  }
+
+  // solves for the box size
+  const int kPadding = 4;
+  const int kHeightLine = dc.GetCharHeight();
+  int width = 0;
+  for (auto iter = lines.cbegin(); iter != lines.cend(); iter++) {
+    width = std::max(width, dc.GetTextExtent(*iter).GetWidth());
+  }
+
+  // draws the box and text in the upper left corner
+  dc.SetBrush(*wxBLACK_BRUSH);
+  dc.SetPen(*wxWHITE_PEN);
+  const int kNumLines = static_cast<int>(lines.size());
+  dc.DrawRectangle(0, 0, width + 2 * kPadding,
+                   kHeightLine * kNumLines + 2 * kPadding);
+
+  dc.SetBackgroundMode(wxTRANSPARENT);
+  dc.SetTextForeground(*wxWHITE);
+  for (int i = 0; i < kNumLines; i++) {
+    dc.DrawText(lines[i], kPadding, kPadding + kHeightLine * i);
+  }
+}
+
+void PlotPane2d::RenderAsync(wxDC& dc, const wxRect& rc) {
+  // fits the plot first so the transform matches what will be rendered
+  plot_.FitToRect(rc);
+
+  const wxBrush background = plot_.background();
+  const Plot2dTransform transform = plot_.Transform();
+  const uint64_t version = plot_.VersionData();
+
+  // requests a new frame if anything changed since the last request
+  // no frame is requested while the datasets are being updated, and the
+  // latest frame is drawn instead
+  const bool is_changed = (is_requested_ == false)
+      || (size_request_.GetWidth() != rc.GetWidth())
+      || (size_request_.GetHeight() != rc.GetHeight())
+      || (background.GetColour() != colour_request_)
+      || (version != version_request_)
+      || (IsEqual(transform, transform_request_) == false);
+  if ((count_update_ == 0) && (is_changed == true)) {
+    // renders on this thread if the plot cannot be handed to the worker
+    if (worker_->Request(&plot_, rc.GetSize(), transform,
+                         background.GetColour()) == false) {
+      plot_.RenderParallel(dc, rc, num_threads_);
+      return;
+    }
+
+    colour_request_ = background.GetColour();
+    size_request_ = rc.GetSize();
+    transform_request_ = transform;
+    version_request_ = version;
+    is_requested_ = true;
+  }
+
+  // updates the frame bitmap if a newer frame has completed
+  wxImage image;
+  Plot2dTransform transform_frame;
+  if (worker_->Frame(id_frame_, image, transform_frame) == true) {
+    bitmap_frame_ = wxBitmap(image);
+    transform_frame_ = transform_frame;
+  }
+
+  // clears the background
+  dc.SetBackgroundMode(wxSOLID);
+  dc.SetBackground(background);
+  dc.Clear();
+
+  if (bitmap_frame_.IsOk() == false) {
+    return;
+  }
+
+  // maps the frame onto the current transform
+  // this previews pans and zooms until the requested frame completes
+  const float kScaleFrameX = transform_frame_.scale * transform_frame_.scale_x;
+  const float kScaleFrameY = transform_frame_.scale * transform_frame_.scale_y;
+  const float kScaleX = transform.scale * transform.scale_x;
+  const float kScaleY = transform.scale * transform.scale_y;
+
+  const int x = rc.GetX() + static_cast<int>(std::lround(
+      (transform_frame_.offset.x - transform.offset.x) * kScaleX));
+  const int y = rc.GetY() + static_cast<int>(std::lround(
+      (transform.offset.y - transform_frame_.offset.y) * kScaleY));
+
+  wxMemoryDC dc_frame(bitmap_frame_);
+  if ((kScaleFrameX == kScaleX) && (kScaleFrameY == kScaleY)) {
+    dc.Blit(x, y, bitmap_frame_.GetWidth(), bitmap_frame_.GetHeight(),
+            &dc_frame, 0, 0);
+  } else {
+    const int kWidth = static_cast<int>(std::lround(
+        bitmap_frame_.GetWidth() * kScaleX / kScaleFrameX));
+    const int kHeight = static_cast<int>(std::lround(
+        bitmap_frame_.GetHeight() * kScaleY / kScaleFrameY));
+
+    dc.StretchBlit(x, y, kWidth, kHeight, &dc_frame, 0, 0,
+                   bitmap_frame_.GetWidth(), bitmap_frame_.GetHeight());
+  }
+}
+
+void PlotPane2d::ScheduleFrame() {
+  // skips if a repaint is already pending
+  if ((is_scheduled_ == true) || (timer_frame_.IsRunning() == true)) {
+    return;
+  }
+
+  // solves for the frame interval
+  // a slow paint extends the interval, so input events are still handled
+  // between paints instead of queueing behind them
+  const double interval = std::max(static_cast<double>(budget_frame_),
+                                   duration_paint_);
+  const std::chrono::duration<double, std::milli> elapsed =
+      std::chrono::steady_clock::now() - time_paint_;
+
+  if (interval <= elapsed.count()) {
+    // repaints immediately
+    is_scheduled_ = true;
+    RefreshFrame();
+  } else {
+    // repaints when the interval has elapsed
+    const int delay = static_cast<int>(std::ceil(interval - elapsed.count()));
+    timer_frame_.StartOnce(delay);
+  }
+}
+
+void PlotPane2d::UpdateCache(const wxRect& rc) {
+  // fits the plot first so the transform matches what will be rendered
+  plot_.FitToRect(rc);
+
+  const wxColour colour = plot_.background().GetColour();
+  const Point2d<float> offset = plot_.offset();
+  const float scale = plot_.scale();
+  const float scale_x = plot_.scale_x();
+  const float scale_y = plot_.scale_y();
+  const uint64_t version = plot_.VersionData();
+
+  // checks if the cached bitmap can be reused
+  bool is_rendered_full = (is_updated_cache_ == false)
+      || (bitmap_cache_.IsOk() == false)
+      || (bitmap_cache_.GetWidth() != rc.GetWidth())
+      || (bitmap_cache_.GetHeight() != rc.GetHeight())
+      || (colour != colour_cache_)
+      || (scale != scale_cache_)
+      || (scale_x != scale_x_cache_)
+      || (scale_y != scale_y_cache_)
+      || (version != version_cache_);
+
+  // solves for the pixel shift of the cached bitmap
+  int shift_x = 0;
+  int shift_y = 0;
+  if (is_rendered_full == false) {
+    shift_x = static_cast<int>(std::lround(
+        (offset_cache_.x - offset.x) * scale * scale_x));
+    shift_y = static_cast<int>(std::lround(
+        (offset.y - offset_cache_.y) * scale * scale_y));
+
+    // renders fully if nothing from the cached bitmap would remain visible
+    if ((rc.GetWidth() <= std::abs(shift_x))
+        || (rc.GetHeight() <= std::abs(shift_y))) {
+      is_rendered_full = true;
+    }
+
+    // renders fully if fitted, as the fit depends on the full render rect
+    if ((plot_.is_fitted() == true) && ((shift_x != 0) || (shift_y != 0))) {
+      is_rendered_full = true;
+    }
+  }
+
+  if (is_rendered_full == true) {
+    // renders the entire plot
+    bitmap_cache_ = wxBitmap(rc.GetWidth(), rc.GetHeight());
+    wxMemoryDC dc_cache(bitmap_cache_);
+    plot_.RenderParallel(dc_cache, wxRect(0, 0, rc.GetWidth(), rc.GetHeight()),
+                         num_threads_);
+    is_shifted_cache_ = false;
+  } else if ((shift_x != 0) || (shift_y != 0)) {
+    // copies the still visible part of the cached bitmap into a new bitmap
+    wxBitmap bitmap(rc.GetWidth(), rc.GetHeight());
+    wxMemoryDC dc(bitmap);
+    {
+      wxMemoryDC dc_cache(bitmap_cache_);
+      dc.Blit(shift_x, shift_y, rc.GetWidth(), rc.GetHeight(), &dc_cache,
+              0, 0);
+    }
+
+    // solves for the exposed strips
+    // the vertical strip covers the full height, and the horizontal strip
+    // covers the remaining width
+    wxRect strips[2];
+    if (0 < shift_x) {
+      strips[0] = wxRect(0, 0, shift_x, rc.GetHeight());
+    } else if (shift_x < 0) {
+      strips[0] = wxRect(rc.GetWidth() + shift_x, 0, -shift_x,
+                         rc.GetHeight());
+    }
+
+    const int kStripX = std::max(shift_x, 0);
+    const int kStripWidth = rc.GetWidth() - std::abs(shift_x);
+    if (0 < shift_y) {
+      strips[1] = wxRect(kStripX, 0, kStripWidth, shift_y);
+    } else if (shift_y < 0) {
+      strips[1] = wxRect(kStripX, rc.GetHeight() + shift_y, kStripWidth,
+                         -shift_y);
+    }
+
+    // renders each strip with a border on each side, and copies the strip
+    // within the border into the new bitmap
+    for (int i = 0; i < 2; i++) {
+      const wxRect& strip = strips[i];
+      if ((strip.GetWidth() <= 0) || (strip.GetHeight() <= 0)) {
+        continue;
+      }
+
+      const wxRect rc_strip(strip.GetX() - kSizeGutterStrip,
+                            strip.GetY() - kSizeGutterStrip,
+                            strip.GetWidth() + 2 * kSizeGutterStrip,
+                            strip.GetHeight() + 2 * kSizeGutterStrip);
+
+      wxBitmap bitmap_strip(rc_strip.GetWidth(), rc_strip.GetHeight());
+      wxMemoryDC dc_strip(bitmap_strip);
+      plot_.Render(dc_strip, rc_strip);
+
+      dc.Blit(strip.GetX(), strip.GetY(), strip.GetWidth(), strip.GetHeight(),
+              &dc_strip, kSizeGutterStrip, kSizeGutterStrip);
+    }
+
+    dc.SelectObject(wxNullBitmap);
+    bitmap_cache_ = bitmap;
+    is_shifted_cache_ = true;
+  }
+
+  // updates the cached transform
+  colour_cache_ = colour;
+  offset_cache_ = offset;
+  scale_cache_ = scale;
+  scale_x_cache_ = scale_x;
+  scale_y_cache_ = scale_y;
+  version_cache_ = version;
+  is_updated_cache_ = true;
+}
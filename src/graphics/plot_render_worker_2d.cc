@@ -0,0 +1,196 @@
+// This is free and unencumbered software released into the public domain.
+// For more information, please refer to <http://unlicense.org/>
+
+#include "appcommon/graphics/plot_render_worker_2d.h"
+
+PlotRenderWorker2d::PlotRenderWorker2d(wxEvtHandler* handler,
+                                       const int& id_event) {
+  dc_request_ = nullptr;
+  handler_ = handler;
+  id_event_ = id_event;
+  id_frame_ = 0;
+  image_request_ = nullptr;
+  is_busy_ = false;
+  is_cancelled_ = false;
+  is_pending_ = false;
+  is_stopped_ = false;
+  plot_request_ = nullptr;
+
+  // starts the worker thread after all members are initialized
+  thread_ = std::thread(&PlotRenderWorker2d::Run, this);
+}
+
+PlotRenderWorker2d::~PlotRenderWorker2d() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    is_pending_ = false;
+    is_cancelled_ = true;
+    is_stopped_ = true;
+  }
+  condition_.notify_all();
+
+  thread_.join();
+
+  // deletes any request that the worker did not take
+  std::lock_guard<std::mutex> lock(mutex_);
+  ClearRequest();
+}
+
+void PlotRenderWorker2d::Cancel() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  ClearRequest();
+  is_pending_ = false;
+  is_cancelled_ = true;
+
+  // waits for the in-flight frame to stop
+  condition_.wait(lock, [this]() { return is_busy_ == false; });
+}
+
+bool PlotRenderWorker2d::Frame(uint64_t& id, wxImage& image,
+                               Plot2dTransform& transform) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if ((id_frame_ == 0) || (id_frame_ == id)) {
+    return false;
+  }
+
+  // copies the image data, as wxImage reference counting is not thread safe
+  id = id_frame_;
+  image = image_frame_.Copy();
+  transform = transform_frame_;
+
+  return true;
+}
+
+bool PlotRenderWorker2d::Request(const Plot2d* plot, const wxSize& size,
+                                 const Plot2dTransform& transform,
+                                 const wxColour& background) {
+  // checks if the size is valid
+  if ((size.GetWidth() <= 0) || (size.GetHeight() <= 0)) {
+    return false;
+  }
+
+  // clones the plot on this thread, which owns the renderer styles
+  Plot2d* plot_clone = plot->Clone();
+  if (plot_clone == nullptr) {
+    return false;
+  }
+
+  // builds any outdated dataset indexes on this thread, so the worker and
+  // any picks on this thread only read the datasets
+  plot->Prepare();
+
+  // creates the device context on this thread, so the worker never copies
+  // or releases the stock styles
+  wxImage* image = new wxImage(size.GetWidth(), size.GetHeight());
+  wxDC* dc = Plot2d::CreateDcImage(*image, background);
+  if (dc == nullptr) {
+    delete image;
+    delete plot_clone;
+    return false;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    // replaces any pending request and cancels the in-flight frame
+    ClearRequest();
+    dc_request_ = dc;
+    image_request_ = image;
+    plot_request_ = plot_clone;
+    transform_request_ = transform;
+
+    is_pending_ = true;
+    is_cancelled_ = true;
+  }
+  condition_.notify_all();
+
+  return true;
+}
+
+std::vector<Renderer2dStatistics> PlotRenderWorker2d::Statistics() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return statistics_frame_;
+}
+
+void PlotRenderWorker2d::ClearRequest() {
+  // the device context is deleted first, as it draws into the image
+  delete dc_request_;
+  delete image_request_;
+  delete plot_request_;
+
+  dc_request_ = nullptr;
+  image_request_ = nullptr;
+  plot_request_ = nullptr;
+}
+
+void PlotRenderWorker2d::Run() {
+  while (true) {
+    // waits for a request
+    std::unique_lock<std::mutex> lock(mutex_);
+    condition_.wait(lock, [this]() {
+      return (is_pending_ == true) || (is_stopped_ == true);
+    });
+
+    if (is_stopped_ == true) {
+      return;
+    }
+
+    // takes ownership of the request
+    wxDC* dc = dc_request_;
+    wxImage* image = image_request_;
+    Plot2d* plot = plot_request_;
+    const Plot2dTransform transform = transform_request_;
+
+    dc_request_ = nullptr;
+    image_request_ = nullptr;
+    plot_request_ = nullptr;
+
+    is_pending_ = false;
+    is_cancelled_ = false;
+    is_busy_ = true;
+    lock.unlock();
+
+    // renders the frame
+    dc->Clear();
+    const bool is_completed = plot->RenderTransformed(
+        *dc, wxRect(0, 0, image->GetWidth(), image->GetHeight()), transform,
+        &is_cancelled_);
+
+    // copies the statistics while the renderers are still owned by this
+    // thread
+    std::vector<Renderer2dStatistics> statistics;
+    if (is_completed == true) {
+      statistics = plot->Statistics();
+    }
+
+    // the device context must be destroyed before the image is complete
+    // none of the deleted styles are shared with the UI thread
+    delete dc;
+    delete plot;
+
+    // stores the frame and notifies any waiting callers
+    lock.lock();
+    is_busy_ = false;
+
+    const bool is_updated = (is_completed == true)
+                            && (is_cancelled_ == false);
+    if (is_updated == true) {
+      image_frame_ = *image;
+      transform_frame_ = transform;
+      statistics_frame_ = statistics;
+      id_frame_++;
+    }
+
+    // releases the image while locked, so the shared reference count is
+    // never modified concurrently
+    delete image;
+    lock.unlock();
+
+    condition_.notify_all();
+
+    // notifies the event handler, which processes the event on the UI thread
+    if (is_updated == true) {
+      wxQueueEvent(handler_, new wxThreadEvent(wxEVT_THREAD, id_event_));
+    }
+  }
+}
@@ -0,0 +1,226 @@
+// This is free and unencumbered software released into the public domain.
+// For more information, please refer to <http://unlicense.org/>
+
+#include "appcommon/graphics/plot_tile_cache_2d.h"
+
+#include <cmath>
+
+namespace {
+
+/// The width of the border that is rendered around each tile, in pixels.
+/// Text and markers are culled by their anchor point, so the border draws the
+/// parts that overlap the tile from anchors in the neighboring tiles.
+const int kSizeGutter = 64;
+
+/// The width and height of a tile, in pixels.
+const int kSizeTile = 256;
+
+/// The memory of a tile, in bytes. This assumes 32 bits per pixel.
+const std::size_t kMemoryTile = kSizeTile * kSizeTile * 4;
+
+/// The number of zoom levels for every doubling of the plot scale. Tiles are
+/// stretched by up to half a level when compositing.
+const int kNumLevelsOctave = 8;
+
+}  // namespace
+
+bool PlotTileKey2d::operator<(const PlotTileKey2d& other) const {
+  if (level != other.level) {
+    return level < other.level;
+  } else if (row != other.row) {
+    return row < other.row;
+  } else {
+    return column < other.column;
+  }
+}
+
+PlotTileCache2d::PlotTileCache2d() {
+  budget_memory_ = 64 * 1024 * 1024;
+  scale_x_ = -999999;
+  scale_y_ = -999999;
+  version_ = 0;
+}
+
+PlotTileCache2d::~PlotTileCache2d() {
+}
+
+void PlotTileCache2d::Clear() {
+  index_.clear();
+  tiles_.clear();
+}
+
+void PlotTileCache2d::Render(const Plot2d& plot, wxDC& dc, const wxRect& rc) {
+  // fits the plot first so the transform matches what will be rendered
+  plot.FitToRect(rc);
+
+  const wxColour colour = plot.background().GetColour();
+  const Plot2dTransform transform = plot.Transform();
+  const uint64_t version = plot.VersionData();
+
+  // renders directly if the transform cannot be tiled
+  if ((plot.HasRenderers() == false) || (transform.scale <= 0)
+      || (transform.scale_x <= 0) || (transform.scale_y <= 0)) {
+    plot.Render(dc, rc);
+    return;
+  }
+
+  // releases the tiles if anything besides the view has changed
+  if ((colour != colour_) || (version != version_)
+      || (transform.scale_x != scale_x_) || (transform.scale_y != scale_y_)) {
+    Clear();
+
+    colour_ = colour;
+    scale_x_ = transform.scale_x;
+    scale_y_ = transform.scale_y;
+    version_ = version;
+  }
+
+  // solves for the nearest zoom level and its scale
+  const int level = static_cast<int>(std::lround(
+      std::log2(transform.scale) * kNumLevelsOctave));
+  const double scale_level = std::exp2(
+      static_cast<double>(level) / kNumLevelsOctave);
+
+  // solves for the view origin in the level graphics coordinates, and the
+  // ratio that maps the level graphics coordinates to the view
+  // doubles are used as the level coordinates can exceed the float precision
+  // for long datasets, and the tile axes are solved from these as well
+  const double ratio = transform.scale / scale_level;
+  const double x_origin = static_cast<double>(transform.offset.x)
+                          * scale_level * transform.scale_x;
+  const double y_origin = -static_cast<double>(transform.offset.y)
+                          * scale_level * transform.scale_y;
+
+  // solves for the visible tiles
+  const int64_t column_min = static_cast<int64_t>(
+      std::floor(x_origin / kSizeTile));
+  const int64_t column_max = static_cast<int64_t>(
+      std::floor((x_origin + rc.GetWidth() / ratio) / kSizeTile));
+  const int64_t row_min = static_cast<int64_t>(
+      std::floor(y_origin / kSizeTile));
+  const int64_t row_max = static_cast<int64_t>(
+      std::floor((y_origin + rc.GetHeight() / ratio) / kSizeTile));
+
+  // composites the visible tiles, rendering any that are not cached
+  // the tile edges are rounded independently so neighboring tiles do not
+  // leave gaps
+  dc.SetClippingRegion(rc);
+
+  std::size_t num_visible = 0;
+  for (int64_t row = row_min; row <= row_max; row++) {
+    const int y0 = rc.GetY() + static_cast<int>(std::lround(
+        (row * kSizeTile - y_origin) * ratio));
+    const int y1 = rc.GetY() + static_cast<int>(std::lround(
+        ((row + 1) * kSizeTile - y_origin) * ratio));
+
+    for (int64_t column = column_min; column <= column_max; column++) {
+      const int x0 = rc.GetX() + static_cast<int>(std::lround(
+          (column * kSizeTile - x_origin) * ratio));
+      const int x1 = rc.GetX() + static_cast<int>(std::lround(
+          ((column + 1) * kSizeTile - x_origin) * ratio));
+
+      PlotTileKey2d key;
+      key.column = column;
+      key.level = level;
+      key.row = row;
+
+      wxMemoryDC dc_tile;
+      dc_tile.SelectObjectAsSource(Tile(plot, key, scale_level));
+      if ((x1 - x0 == kSizeTile) && (y1 - y0 == kSizeTile)) {
+        dc.Blit(x0, y0, kSizeTile, kSizeTile, &dc_tile, 0, 0);
+      } else {
+        dc.StretchBlit(x0, y0, x1 - x0, y1 - y0, &dc_tile, 0, 0, kSizeTile,
+                       kSizeTile);
+      }
+
+      num_visible++;
+    }
+  }
+
+  dc.DestroyClippingRegion();
+
+  // releases tiles that are over the memory budget
+  Evict(num_visible);
+}
+
+std::size_t PlotTileCache2d::Size() const {
+  return tiles_.size();
+}
+
+std::size_t PlotTileCache2d::budget_memory() const {
+  return budget_memory_;
+}
+
+void PlotTileCache2d::set_budget_memory(const std::size_t& budget_memory) {
+  budget_memory_ = budget_memory;
+}
+
+void PlotTileCache2d::Evict(const std::size_t& num_visible) {
+  while ((num_visible < tiles_.size())
+         && (budget_memory_ < tiles_.size() * kMemoryTile)) {
+    index_.erase(tiles_.back().key);
+    tiles_.pop_back();
+  }
+}
+
+wxBitmap PlotTileCache2d::RenderTile(const Plot2d& plot,
+                                     const PlotTileKey2d& key,
+                                     const double& scale_level) const {
+  // the tile is rendered with a border on each side
+  const int kSizeRender = kSizeTile + 2 * kSizeGutter;
+
+  // solves for the axes of the rendered region
+  // the centers are solved in doubles from the tile indexes, and are only
+  // rounded to floats by the axes
+  const double scale_x = scale_level * scale_x_;
+  const double scale_y = scale_level * scale_y_;
+  const double center_column = key.column * kSizeTile - kSizeGutter
+                               + kSizeRender / 2.0;
+  const double center_row = key.row * kSizeTile - kSizeGutter
+                            + kSizeRender / 2.0;
+
+  PlotAxis axis_horizontal(PlotAxis::OrientationType::kHorizontal);
+  axis_horizontal.set_position_center(center_column / scale_x);
+  axis_horizontal.set_range(kSizeRender / scale_x);
+
+  PlotAxis axis_vertical(PlotAxis::OrientationType::kVertical);
+  axis_vertical.set_position_center(-center_row / scale_y);
+  axis_vertical.set_range(kSizeRender / scale_y);
+
+  // clears the background and renders
+  wxBitmap bitmap(kSizeRender, kSizeRender);
+  wxMemoryDC dc(bitmap);
+  dc.SetBackgroundMode(wxSOLID);
+  dc.SetBackground(plot.background());
+  dc.Clear();
+
+  plot.RenderAxes(dc, wxRect(0, 0, kSizeRender, kSizeRender),
+                  axis_horizontal, axis_vertical, nullptr);
+
+  dc.SelectObject(wxNullBitmap);
+
+  // keeps the tile within the border
+  return bitmap.GetSubBitmap(wxRect(kSizeGutter, kSizeGutter, kSizeTile,
+                                    kSizeTile));
+}
+
+const wxBitmap& PlotTileCache2d::Tile(const Plot2d& plot,
+                                      const PlotTileKey2d& key,
+                                      const double& scale_level) {
+  // moves a cached tile to the front of the list
+  auto iter = index_.find(key);
+  if (iter != index_.end()) {
+    tiles_.splice(tiles_.begin(), tiles_, iter->second);
+    return tiles_.front().bitmap;
+  }
+
+  // renders the tile and adds it to the front of the list
+  PlotTile2d tile;
+  tile.bitmap = RenderTile(plot, key, scale_level);
+  tile.key = key;
+
+  tiles_.push_front(tile);
+  index_[key] = tiles_.begin();
+
+  return tiles_.front().bitmap;
+}
@@ -4,9 +4,10 @@
 #include "appcommon/graphics/point_data_set_2d.h"
 
 #include <algorithm>
+#include <cmath>
 
 PointDataSet2d::PointDataSet2d() {
-  is_updated_ = false;
+  is_updated_data_ = false;
 }
 
 PointDataSet2d::~PointDataSet2d() {
@@ -14,80 +15,121 @@ PointDataSet2d::~PointDataSet2d() {
 }
 
 void PointDataSet2d::Add(const Point2d<float>* point) {
-  data_.push_back(point);
+  // keeps the pointer, which is deleted when the dataset is cleared
+  pointers_.push_back(point);
+  AddElement(point);
+}
 
-  is_updated_ = false;
+void PointDataSet2d::Add(const Point2d<float>& point) {
+  AddElement(arena_.Emplace(point));
 }
 
 void PointDataSet2d::Clear() {
-  for (auto iter = data_.begin(); iter != data_.end(); iter++) {
-    const Point2d<float>* point = *iter;
-    delete point;
+  for (auto iter = pointers_.begin(); iter != pointers_.end(); iter++) {
+    delete *iter;
   }
 
+  pointers_.clear();
+  elements_.clear();
+  arena_.Clear();
   data_.clear();
 
-  is_updated_ = false;
+  ResetLimits();
+  version_++;
+
+  is_updated_data_ = false;
+  is_updated_index_ = false;
 }
 
 float PointDataSet2d::MaxX() const {
-  if (is_updated_ == false) {
-    Update();
-  }
-
   return x_max_;
 }
 
 float PointDataSet2d::MaxY() const {
-  if (is_updated_ == false) {
-    Update();
-  }
-
   return y_max_;
 }
 
 float PointDataSet2d::MinX() const {
-  if (is_updated_ == false) {
-    Update();
-  }
-
   return x_min_;
 }
 
 float PointDataSet2d::MinY() const {
-  if (is_updated_ == false) {
-    Update();
+  return y_min_;
+}
+
+bool PointDataSet2d::Nearest(const Point2d<float>& point, const float& scale_x,
+                             const float& scale_y, const float& radius,
+                             unsigned int& index, float& distance) const {
+  // gets the candidate elements
+  // every element is checked if the dataset does not build an index
+  std::vector<unsigned int> indexes;
+  const bool is_queried = IndexesPick(point, scale_x, scale_y, radius,
+                                      indexes);
+
+  // searches for the nearest element
+  // later elements are drawn on top, so they are preferred on ties
+  bool is_found = false;
+  distance = radius;
+  const std::size_t size = (is_queried == true) ? indexes.size()
+                                                : elements_.size();
+  for (std::size_t j = 0; j < size; j++) {
+    const unsigned int i = (is_queried == true) ? indexes[j] : j;
+    const Point2d<float>* p = elements_[i];
+    const float d = std::hypot((p->x - point.x) * scale_x,
+                               (p->y - point.y) * scale_y);
+
+    if (d <= distance) {
+      distance = d;
+      index = i;
+      is_found = true;
+    }
   }
 
-  return y_min_;
+  return is_found;
+}
+
+std::size_t PointDataSet2d::Size() const {
+  return elements_.size();
 }
 
 const std::list<const Point2d<float>*>* PointDataSet2d::data() const {
+  if (is_updated_data_ == false) {
+    data_.assign(elements_.cbegin(), elements_.cend());
+    is_updated_data_ = true;
+  }
+
   return &data_;
 }
 
-void PointDataSet2d::Update() const {
-  // initializes
-  x_min_ = 999999;
-  x_max_ = -999999;
+const std::vector<const Point2d<float>*>* PointDataSet2d::elements() const {
+  return &elements_;
+}
 
-  y_min_ = 999999;
-  y_max_ = -999999;
+void PointDataSet2d::AddElement(const Point2d<float>* point) {
+  elements_.push_back(point);
 
-  // checks if data exists, exits if not
-  if (data_.empty() == true) {
-    return;
-  }
+  ExtendLimits(point->x, point->y);
+  version_++;
 
-  for (auto iter = data_.cbegin(); iter != data_.cend(); iter++) {
-    const Point2d<float>* point = *iter;
+  is_updated_data_ = false;
+  is_updated_index_ = false;
+}
 
-    x_min_ = std::min(point->x, x_min_);
-    x_max_ = std::max(point->x, x_max_);
+bool PointDataSet2d::UpdateIndex() const {
+  std::vector<BoundingBox2d> boxes;
+  boxes.reserve(elements_.size());
+  for (auto iter = elements_.cbegin(); iter != elements_.cend(); iter++) {
+    const Point2d<float>* point = *iter;
 
-    y_min_ = std::min(point->y, y_min_);
-    y_max_ = std::max(point->y, y_max_);
+    BoundingBox2d box;
+    box.x_min = point->x;
+    box.x_max = point->x;
+    box.y_min = point->y;
+    box.y_max = point->y;
+    boxes.push_back(box);
   }
 
-  is_updated_ = true;
+  index_.Build(boxes);
+
+  return true;
 }
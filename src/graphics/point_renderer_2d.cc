@@ -3,10 +3,21 @@
 
 #include "appcommon/graphics/point_renderer_2d.h"
 
+#include <vector>
+
+#include "appcommon/graphics/graphics_kernel_2d.h"
+
 PointRenderer2d::PointRenderer2d() {
   pen_ = nullptr;
 }
 
+Renderer2d* PointRenderer2d::Clone() const {
+  PointRenderer2d* renderer = new PointRenderer2d(*this);
+  renderer->pen_ = renderer->CopyStyle(pen_);
+
+  return renderer;
+}
+
 void PointRenderer2d::Draw(wxDC& dc, wxRect rc, const PlotAxis& axis_horizontal,
                            const PlotAxis& axis_vertical) const {
   // sets drawing pen
@@ -26,43 +37,58 @@ void PointRenderer2d::Draw(wxDC& dc, wxRect rc, const PlotAxis& axis_horizontal,
     dc.SetPen(*pen_);
   }
 
-  // casts to point dataset
-  const PointDataSet2d* dataset = dynamic_cast<const PointDataSet2d*>(dataset_);
-
-  // draws each point in dataset
-  const std::list<const Point2d<float>*>* data = dataset->data();
-  for (auto iter = data->cbegin(); iter != data->cend(); iter++) {
-    // gets point
-    const Point2d<float>* line = *iter;
-
-    // gets points to draw
-    const float& x = line->x;
-    const float& y = line->y;
-
-    // skips points that are out of range
-    if (x < axis_horizontal.Min()) {
-      continue;
-    } else if (axis_horizontal.Max() < x) {
-      continue;
-    } else if (y < axis_vertical.Min()) {
-      continue;
-    } else if (axis_vertical.Max() < y) {
-      continue;
+  // transforms the visible points, reusing the cached coordinates if possible
+  std::vector<wxPoint> points;
+  std::vector<unsigned int> indexes;
+  if (is_cached_ == true) {
+    if (cache_.IsValid(axis_horizontal, axis_vertical, rc,
+                       dataset_->version()) == false) {
+      PlotAxis axis_horizontal_cache;
+      PlotAxis axis_vertical_cache;
+      wxRect rc_cache;
+      VertexCache2d::Region(axis_horizontal, axis_vertical, rc,
+                            axis_horizontal_cache, axis_vertical_cache,
+                            rc_cache);
+
+      std::vector<wxPoint> points_cache;
+      std::vector<unsigned int> indexes_cache;
+      TransformPoints(rc_cache, axis_horizontal_cache, axis_vertical_cache,
+                      points_cache, indexes_cache);
+      cache_.Update(axis_horizontal, axis_vertical, rc, axis_horizontal_cache,
+                    axis_vertical_cache, dataset_->version(), 0,
+                    points_cache, indexes_cache);
     }
 
-    // translates to graphics coordinates
-    wxCoord xg, yg;
+    cache_.Points(axis_horizontal, axis_vertical, rc, points, indexes);
+  } else {
+    TransformPoints(rc, axis_horizontal, axis_vertical, points, indexes);
+  }
 
-    xg = DataToGraphics(x, axis_horizontal.Min(), axis_horizontal.Max(),
-                        rc.GetWidth(), false);
-    yg = DataToGraphics(y, axis_vertical.Min(), axis_vertical.Max(),
-                        rc.GetHeight(), true);
+  // updates the statistics
+  statistics_.count_drawn = points.size();
+  statistics_.count_total = dataset()->Size();
 
-    // draws onto DC
-    dc.DrawPoint(xg, yg);
+  // draws onto DC
+  for (auto iter = points.cbegin(); iter != points.cend(); iter++) {
+    const wxPoint& point = *iter;
+    dc.DrawPoint(point.x, point.y);
   }
 }
 
+void PointRenderer2d::Export(wxDC& dc, SvgWriter2d& writer, wxRect rc,
+                             const PlotAxis& axis_horizontal,
+                             const PlotAxis& axis_vertical) const {
+  // sets the style
+  const wxPen pen = PenContrasted(*pen_, dc.GetBackground().GetColour());
+  writer.SetStyle(&pen, nullptr);
+
+  // transforms and writes the visible points
+  std::vector<wxRealPoint> points;
+  std::vector<unsigned int> indexes;
+  TransformPoints(rc, axis_horizontal, axis_vertical, points, indexes);
+  writer.WritePoints(points);
+}
+
 const wxPen* PointRenderer2d::pen() const {
   return pen_;
 }
@@ -70,3 +96,40 @@ const wxPen* PointRenderer2d::pen() const {
 void PointRenderer2d::set_pen(const wxPen* pen) {
   pen_ = pen;
 }
+
+template <typename T>
+void PointRenderer2d::TransformPoints(
+    const wxRect& rc, const PlotAxis& axis_horizontal,
+    const PlotAxis& axis_vertical, std::vector<T>& points,
+    std::vector<unsigned int>& indexes) const {
+  // gets the typed point dataset
+  const PointDataSet2d* dataset = this->dataset();
+
+  // gets the visible elements from the spatial index, if available
+  const std::vector<const Point2d<float>*>* data = dataset->elements();
+  std::vector<unsigned int> indexes_visible;
+  const bool is_indexed = dataset->IndexesVisible(axis_horizontal,
+                                                  axis_vertical,
+                                                  indexes_visible);
+  const std::size_t count = is_indexed ? indexes_visible.size() : data->size();
+
+  // gathers the point coordinates into contiguous arrays
+  std::vector<float> x(count);
+  std::vector<float> y(count);
+  for (std::size_t k = 0; k < count; k++) {
+    const Point2d<float>* point = (*data)[is_indexed ? indexes_visible[k] : k];
+    x[k] = point->x;
+    y[k] = point->y;
+  }
+
+  // transforms and culls the points
+  const GraphicsKernel2d kernel(axis_horizontal, axis_vertical, rc);
+  kernel.TransformPoints(x.data(), y.data(), nullptr, count, points, indexes);
+
+  // maps the gathered array positions back to dataset element indexes
+  if (is_indexed == true) {
+    for (auto iter = indexes.begin(); iter != indexes.end(); iter++) {
+      *iter = indexes_visible[*iter];
+    }
+  }
+}
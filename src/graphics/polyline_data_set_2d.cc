@@ -0,0 +1,158 @@
+// This is free and unencumbered software released into the public domain.
+// For more information, please refer to <http://unlicense.org/>
+
+#include "appcommon/graphics/polyline_data_set_2d.h"
+
+#include <algorithm>
+#include <cmath>
+
+PolylineDataSet2d::PolylineDataSet2d() {
+  offsets_.push_back(0);
+}
+
+PolylineDataSet2d::~PolylineDataSet2d() {
+  Clear();
+}
+
+void PolylineDataSet2d::Add(const std::vector<Point2d<float>>& points) {
+  for (auto iter = points.cbegin(); iter != points.cend(); iter++) {
+    const Point2d<float>& point = *iter;
+    x_.push_back(point.x);
+    y_.push_back(point.y);
+
+    ExtendLimits(point.x, point.y);
+  }
+
+  offsets_.push_back(x_.size());
+  version_++;
+
+  is_updated_index_ = false;
+}
+
+void PolylineDataSet2d::Add(const float* x, const float* y,
+                            const std::size_t& count) {
+  x_.insert(x_.end(), x, x + count);
+  y_.insert(y_.end(), y, y + count);
+
+  for (std::size_t i = 0; i < count; i++) {
+    ExtendLimits(x[i], y[i]);
+  }
+
+  offsets_.push_back(x_.size());
+  version_++;
+
+  is_updated_index_ = false;
+}
+
+void PolylineDataSet2d::Clear() {
+  offsets_.clear();
+  offsets_.push_back(0);
+
+  x_.clear();
+  y_.clear();
+
+  ResetLimits();
+  version_++;
+
+  is_updated_index_ = false;
+}
+
+float PolylineDataSet2d::MaxX() const {
+  return x_max_;
+}
+
+float PolylineDataSet2d::MaxY() const {
+  return y_max_;
+}
+
+float PolylineDataSet2d::MinX() const {
+  return x_min_;
+}
+
+float PolylineDataSet2d::MinY() const {
+  return y_min_;
+}
+
+bool PolylineDataSet2d::Nearest(const Point2d<float>& point,
+                                const float& scale_x, const float& scale_y,
+                                const float& radius, unsigned int& index,
+                                float& distance) const {
+  // gets the candidate elements
+  // every element is checked if the dataset does not build an index
+  std::vector<unsigned int> indexes;
+  const bool is_queried = IndexesPick(point, scale_x, scale_y, radius,
+                                      indexes);
+
+  // searches for the nearest element
+  // later elements are drawn on top, so they are preferred on ties
+  bool is_found = false;
+  distance = radius;
+  const std::size_t size = (is_queried == true) ? indexes.size()
+                                                : offsets_.size() - 1;
+  for (std::size_t j = 0; j < size; j++) {
+    const unsigned int i = (is_queried == true) ? indexes[j] : j;
+    float d = 999999;
+    for (unsigned int k = offsets_[i]; k + 1 < offsets_[i + 1]; k++) {
+      d = std::min(d, DistanceSegment(point, x_[k], y_[k], x_[k + 1],
+                                      y_[k + 1], scale_x, scale_y));
+    }
+
+    if (d <= distance) {
+      distance = d;
+      index = i;
+      is_found = true;
+    }
+  }
+
+  return is_found;
+}
+
+void PolylineDataSet2d::Reserve(const std::size_t& count) {
+  x_.reserve(count);
+  y_.reserve(count);
+}
+
+std::size_t PolylineDataSet2d::Size() const {
+  return offsets_.size() - 1;
+}
+
+std::size_t PolylineDataSet2d::SizeVertices() const {
+  return x_.size();
+}
+
+PolylineDataSpan2d PolylineDataSet2d::Span() const {
+  PolylineDataSpan2d span;
+  span.offsets = offsets_.data();
+  span.size = offsets_.size() - 1;
+  span.x = x_.data();
+  span.y = y_.data();
+
+  return span;
+}
+
+bool PolylineDataSet2d::UpdateIndex() const {
+  const std::size_t size = offsets_.size() - 1;
+
+  std::vector<BoundingBox2d> boxes;
+  boxes.reserve(size);
+  for (std::size_t i = 0; i < size; i++) {
+    BoundingBox2d box;
+    box.x_max = -999999;
+    box.x_min = 999999;
+    box.y_max = -999999;
+    box.y_min = 999999;
+
+    for (unsigned int k = offsets_[i]; k < offsets_[i + 1]; k++) {
+      box.x_min = std::min(box.x_min, x_[k]);
+      box.x_max = std::max(box.x_max, x_[k]);
+      box.y_min = std::min(box.y_min, y_[k]);
+      box.y_max = std::max(box.y_max, y_[k]);
+    }
+
+    boxes.push_back(box);
+  }
+
+  index_.Build(boxes);
+
+  return true;
+}
@@ -0,0 +1,137 @@
+// This is free and unencumbered software released into the public domain.
+// For more information, please refer to <http://unlicense.org/>
+
+#include "appcommon/graphics/polyline_renderer_2d.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "appcommon/graphics/graphics_kernel_2d.h"
+
+PolylineRenderer2d::PolylineRenderer2d() {
+  pen_ = nullptr;
+}
+
+Renderer2d* PolylineRenderer2d::Clone() const {
+  PolylineRenderer2d* renderer = new PolylineRenderer2d(*this);
+  renderer->pen_ = renderer->CopyStyle(pen_);
+
+  return renderer;
+}
+
+void PolylineRenderer2d::Draw(wxDC& dc, wxRect rc,
+                              const PlotAxis& axis_horizontal,
+                              const PlotAxis& axis_vertical) const {
+  // sets drawing pen
+  if ((always_contrast_background_ == true)
+       && (pen_->GetColour() == dc.GetBackground().GetColour())) {
+    // gets the inverse color
+    wxColour color_inverse = InvertColor(pen_->GetColour());
+
+    // creates a new pen with the inverted color
+    wxPen pen = *pen_;
+    pen.SetColour(color_inverse);
+
+    // updates dc with inverted pen
+    dc.SetPen(pen);
+  } else {
+    // updates dc with typical pen
+    dc.SetPen(*pen_);
+  }
+
+  // transforms the visible polylines, reusing the cached coordinates if
+  // possible
+  std::vector<wxPoint> points;
+  if (is_cached_ == true) {
+    if (cache_.IsValid(axis_horizontal, axis_vertical, rc,
+                       dataset_->version()) == false) {
+      PlotAxis axis_horizontal_cache;
+      PlotAxis axis_vertical_cache;
+      wxRect rc_cache;
+      VertexCache2d::Region(axis_horizontal, axis_vertical, rc,
+                            axis_horizontal_cache, axis_vertical_cache,
+                            rc_cache);
+
+      std::vector<wxPoint> points_cache;
+      std::vector<unsigned int> indexes_cache;
+      TransformPolylines(rc_cache, axis_horizontal_cache, axis_vertical_cache,
+                         points_cache);
+      cache_.Update(axis_horizontal, axis_vertical, rc, axis_horizontal_cache,
+                    axis_vertical_cache, dataset_->version(), 0, points_cache,
+                    indexes_cache);
+    }
+
+    cache_.Segments(axis_horizontal, axis_vertical, rc, points);
+  } else {
+    TransformPolylines(rc, axis_horizontal, axis_vertical, points);
+  }
+
+  // updates the statistics
+  // each polyline has one less segment than it has vertices
+  const PolylineDataSet2d* dataset = this->dataset();
+  statistics_.count_drawn = points.size() / 2;
+  statistics_.count_total = dataset->SizeVertices()
+      - std::min(dataset->SizeVertices(), dataset->Size());
+
+  // draws onto DC
+  // connected segments are joined back into one polyline per visible run
+  DrawSegments(dc, points);
+}
+
+void PolylineRenderer2d::Export(wxDC& dc, SvgWriter2d& writer, wxRect rc,
+                                const PlotAxis& axis_horizontal,
+                                const PlotAxis& axis_vertical) const {
+  // sets the style
+  const wxPen pen = PenContrasted(*pen_, dc.GetBackground().GetColour());
+  writer.SetStyle(&pen, nullptr);
+
+  // transforms the visible polylines and writes the visible runs
+  std::vector<wxRealPoint> points;
+  TransformPolylines(rc, axis_horizontal, axis_vertical, points);
+  writer.WriteSegments(points);
+}
+
+const wxPen* PolylineRenderer2d::pen() const {
+  return pen_;
+}
+
+void PolylineRenderer2d::set_pen(const wxPen* pen) {
+  pen_ = pen;
+}
+
+template <typename T>
+void PolylineRenderer2d::TransformPolylines(
+    const wxRect& rc, const PlotAxis& axis_horizontal,
+    const PlotAxis& axis_vertical, std::vector<T>& points) const {
+  // gets the typed polyline dataset
+  const PolylineDataSet2d* dataset = this->dataset();
+
+  // gets the visible polylines from the spatial index, if available
+  const PolylineDataSpan2d data = dataset->Span();
+  std::vector<unsigned int> indexes;
+  const bool is_indexed = dataset->IndexesVisible(axis_horizontal,
+                                                  axis_vertical, indexes);
+  if (is_indexed == false) {
+    indexes.resize(data.size);
+    for (std::size_t i = 0; i < data.size; i++) {
+      indexes[i] = i;
+    }
+  }
+
+  // transforms and clips each polyline into the point buffer
+  // the segments of a polyline are the consecutive vertex pairs, so the
+  // start and end arrays are the vertex arrays offset by one
+  const GraphicsKernel2d kernel(axis_horizontal, axis_vertical, rc);
+  points.clear();
+  for (auto iter = indexes.cbegin(); iter != indexes.cend(); iter++) {
+    const unsigned int begin = data.offsets[*iter];
+    const unsigned int end = data.offsets[*iter + 1];
+    if (end - begin < 2) {
+      continue;
+    }
+
+    kernel.ClipSegments(data.x + begin, data.y + begin,
+                        data.x + begin + 1, data.y + begin + 1,
+                        end - begin - 1, points);
+  }
+}
@@ -3,14 +3,67 @@
 
 #include "appcommon/graphics/renderer_2d.h"
 
+#include <algorithm>
+#include <chrono>  // NOLINT
+
+#include "wx/graphics.h"
+
+namespace {
+
+/// The maximum number of points submitted in a single polyline draw call.
+const std::size_t kSizeChunkPolyline = 4096;
+
+}  // namespace
+
 Renderer2d::Renderer2d() {
   always_contrast_background_ = true;
   dataset_ = nullptr;
+  is_cached_ = false;
+
+  statistics_.count_drawn = 0;
+  statistics_.count_total = 0;
+  statistics_.duration = 0;
+}
+
+Renderer2d::Renderer2d(const Renderer2d& other) {
+  always_contrast_background_ = other.always_contrast_background_;
+  dataset_ = other.dataset_;
+  is_cached_ = other.is_cached_;
+
+  statistics_.count_drawn = 0;
+  statistics_.count_total = 0;
+  statistics_.duration = 0;
 }
 
 Renderer2d::~Renderer2d() {
 }
 
+Renderer2d* Renderer2d::Clone() const {
+  // placeholder for optional override
+  return nullptr;
+}
+
+void Renderer2d::Export(wxDC& dc, SvgWriter2d& writer, wxRect rc,
+                        const PlotAxis& axis_horizontal,
+                        const PlotAxis& axis_vertical) const {
+  // placeholder for optional override
+}
+
+void Renderer2d::Render(wxDC& dc, wxRect rc, const PlotAxis& axis_horizontal,
+                        const PlotAxis& axis_vertical) const {
+  statistics_.count_drawn = 0;
+  statistics_.count_total = 0;
+
+  // draws and measures the elapsed time
+  const std::chrono::steady_clock::time_point time_start =
+      std::chrono::steady_clock::now();
+  Draw(dc, rc, axis_horizontal, axis_vertical);
+  const std::chrono::duration<double, std::milli> duration =
+      std::chrono::steady_clock::now() - time_start;
+
+  statistics_.duration = duration.count();
+}
+
 bool Renderer2d::always_contrast_background() const {
   return always_contrast_background_;
 }
@@ -19,6 +72,10 @@ const DataSet2d* Renderer2d::dataset() const {
   return dataset_;
 }
 
+bool Renderer2d::is_cached() const {
+  return is_cached_;
+}
+
 void Renderer2d::set_always_contrast_background(
     const bool& always_contrast_background) {
   always_contrast_background_ = always_contrast_background;
@@ -26,6 +83,27 @@ void Renderer2d::set_always_contrast_background(
 
 void Renderer2d::set_dataset(const DataSet2d* dataset) {
   dataset_ = dataset;
+  cache_.Clear();
+}
+
+void Renderer2d::set_is_cached(const bool& is_cached) {
+  is_cached_ = is_cached;
+  cache_.Clear();
+}
+
+const Renderer2dStatistics& Renderer2d::statistics() const {
+  return statistics_;
+}
+
+wxBrush Renderer2d::BrushContrasted(const wxBrush& brush,
+                                    const wxColour& background) const {
+  wxBrush brush_contrasted = brush;
+  if ((always_contrast_background_ == true)
+      && (brush.GetColour() == background)) {
+    brush_contrasted.SetColour(InvertColor(brush.GetColour()));
+  }
+
+  return brush_contrasted;
 }
 
 void Renderer2d::ClipHorizontal(const PlotAxis& axis,
@@ -80,6 +158,104 @@ wxCoord Renderer2d::DataToGraphics(const float& value,
   return k * range_graphics;
 }
 
+const wxBrush* Renderer2d::CopyStyle(const wxBrush* brush) {
+  if (brush == nullptr) {
+    return nullptr;
+  }
+
+  // modifying the copy gives it separate data from the original
+  brushes_.push_back(*brush);
+  if (brush->IsOk() == true) {
+    brushes_.back().SetColour(brush->GetColour());
+  }
+
+  return &brushes_.back();
+}
+
+const wxColour* Renderer2d::CopyStyle(const wxColour* colour) {
+  if (colour == nullptr) {
+    return nullptr;
+  }
+
+  // constructs from the components so no data is shared with the original
+  colours_.push_back(wxColour(colour->Red(), colour->Green(), colour->Blue(),
+                              colour->Alpha()));
+
+  return &colours_.back();
+}
+
+const wxPen* Renderer2d::CopyStyle(const wxPen* pen) {
+  if (pen == nullptr) {
+    return nullptr;
+  }
+
+  // modifying the copy gives it separate data from the original
+  pens_.push_back(*pen);
+  if (pen->IsOk() == true) {
+    pens_.back().SetColour(pen->GetColour());
+  }
+
+  return &pens_.back();
+}
+
+void Renderer2d::DrawSegments(wxDC& dc, const std::vector<wxPoint>& points) {
+  // checks if any segments exist
+  if (points.size() < 2) {
+    return;
+  }
+
+#if wxUSE_GRAPHICS_CONTEXT
+  // strokes all segments as one path if a graphics context is available
+  wxGraphicsContext* gc = dc.GetGraphicsContext();
+  if (gc != nullptr) {
+    wxGraphicsPath path = gc->CreatePath();
+    for (std::size_t i = 0; i + 1 < points.size(); i += 2) {
+      const wxPoint& p0 = points[i];
+      const wxPoint& p1 = points[i + 1];
+
+      // only moves the path if the segment does not continue the previous one
+      if ((i == 0) || (p0 != points[i - 1])) {
+        path.MoveToPoint(p0.x, p0.y);
+      }
+      path.AddLineToPoint(p1.x, p1.y);
+    }
+
+    gc->StrokePath(path);
+    return;
+  }
+#endif
+
+  // joins connected segments into polylines
+  std::vector<wxPoint> polyline;
+  polyline.reserve(std::min(points.size(), kSizeChunkPolyline));
+  for (std::size_t i = 0; i + 1 < points.size(); i += 2) {
+    const wxPoint& p0 = points[i];
+    const wxPoint& p1 = points[i + 1];
+
+    // flushes the polyline if the segment is disconnected or the chunk is full
+    if ((polyline.empty() == false)
+        && ((p0 != polyline.back())
+            || (kSizeChunkPolyline <= polyline.size()))) {
+      dc.DrawLines(polyline.size(), polyline.data());
+
+      const bool is_connected = (p0 == polyline.back());
+      polyline.clear();
+
+      // a full chunk is continued from its last point
+      if (is_connected == true) {
+        polyline.push_back(p0);
+      }
+    }
+
+    if (polyline.empty() == true) {
+      polyline.push_back(p0);
+    }
+    polyline.push_back(p1);
+  }
+
+  dc.DrawLines(polyline.size(), polyline.data());
+}
+
 wxColour Renderer2d::InvertColor(const wxColour& color) {
   // calculates the inverted rgb components
   const int r = 255 - color.Red();
@@ -89,3 +265,14 @@ wxColour Renderer2d::InvertColor(const wxColour& color) {
   // returns
   return wxColour(r, g, b);
 }
+
+wxPen Renderer2d::PenContrasted(const wxPen& pen,
+                                const wxColour& background) const {
+  wxPen pen_contrasted = pen;
+  if ((always_contrast_background_ == true)
+      && (pen.GetColour() == background)) {
+    pen_contrasted.SetColour(InvertColor(pen.GetColour()));
+  }
+
+  return pen_contrasted;
+}
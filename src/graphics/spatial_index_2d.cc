@@ -0,0 +1,251 @@
+// This is free and unencumbered software released into the public domain.
+// For more information, please refer to <http://unlicense.org/>
+
+#include "appcommon/graphics/spatial_index_2d.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+/// The target average number of elements in a grid cell.
+const int kNumElementsCell = 4;
+
+/// The maximum number of cells an element can span before it is kept in the
+/// oversized list instead of the grid.
+const int kNumCellsElementMax = 64;
+
+/// The maximum number of cells along each grid axis.
+const int kNumCellsAxisMax = 2048;
+
+}  // namespace
+
+SpatialIndex2d::SpatialIndex2d() {
+  Clear();
+}
+
+SpatialIndex2d::~SpatialIndex2d() {
+}
+
+void SpatialIndex2d::Build(const std::vector<BoundingBox2d>& boxes) {
+  Clear();
+
+  // checks if any boxes exist
+  if (boxes.empty() == true) {
+    return;
+  }
+
+  boxes_ = boxes;
+
+  // solves for the extents of all the boxes
+  for (auto iter = boxes_.cbegin(); iter != boxes_.cend(); iter++) {
+    const BoundingBox2d& box = *iter;
+
+    extents_.x_min = std::min(box.x_min, extents_.x_min);
+    extents_.x_max = std::max(box.x_max, extents_.x_max);
+    extents_.y_min = std::min(box.y_min, extents_.y_min);
+    extents_.y_max = std::max(box.y_max, extents_.y_max);
+  }
+
+  // solves for the grid dimensions, keeping cells roughly square relative to
+  // the extents
+  const float width = extents_.x_max - extents_.x_min;
+  const float height = extents_.y_max - extents_.y_min;
+  const int num_cells = std::max(
+      1, static_cast<int>(boxes_.size()) / kNumElementsCell);
+
+  if ((0 < width) && (0 < height)) {
+    const float ratio = width / height;
+    num_cells_x_ = static_cast<int>(std::sqrt(num_cells * ratio));
+    num_cells_y_ = static_cast<int>(std::sqrt(num_cells / ratio));
+  } else if (0 < width) {
+    num_cells_x_ = num_cells;
+    num_cells_y_ = 1;
+  } else if (0 < height) {
+    num_cells_x_ = 1;
+    num_cells_y_ = num_cells;
+  } else {
+    num_cells_x_ = 1;
+    num_cells_y_ = 1;
+  }
+
+  num_cells_x_ = std::min(std::max(num_cells_x_, 1), kNumCellsAxisMax);
+  num_cells_y_ = std::min(std::max(num_cells_y_, 1), kNumCellsAxisMax);
+
+  size_cell_x_ = width / num_cells_x_;
+  size_cell_y_ = height / num_cells_y_;
+
+  // counts the elements in each cell
+  // the counts are stored one position ahead so they can be accumulated into
+  // the cell offsets
+  const std::size_t kNumCellsTotal =
+      static_cast<std::size_t>(num_cells_x_) * num_cells_y_;
+  cell_offsets_.assign(kNumCellsTotal + 1, 0);
+
+  std::vector<bool> is_oversized(boxes_.size(), false);
+  for (std::size_t i = 0; i < boxes_.size(); i++) {
+    const BoundingBox2d& box = boxes_[i];
+
+    const int ix0 = CellX(box.x_min);
+    const int ix1 = CellX(box.x_max);
+    const int iy0 = CellY(box.y_min);
+    const int iy1 = CellY(box.y_max);
+
+    if (kNumCellsElementMax < (ix1 - ix0 + 1) * (iy1 - iy0 + 1)) {
+      is_oversized[i] = true;
+      indexes_oversized_.push_back(i);
+      continue;
+    }
+
+    for (int iy = iy0; iy <= iy1; iy++) {
+      for (int ix = ix0; ix <= ix1; ix++) {
+        cell_offsets_[iy * num_cells_x_ + ix + 1]++;
+      }
+    }
+  }
+
+  // accumulates the counts into offsets
+  for (std::size_t i = 1; i < cell_offsets_.size(); i++) {
+    cell_offsets_[i] += cell_offsets_[i - 1];
+  }
+
+  // fills the cells
+  cell_indexes_.resize(cell_offsets_.back());
+  std::vector<unsigned int> positions(cell_offsets_.begin(),
+                                      cell_offsets_.end() - 1);
+  for (std::size_t i = 0; i < boxes_.size(); i++) {
+    if (is_oversized[i] == true) {
+      continue;
+    }
+
+    const BoundingBox2d& box = boxes_[i];
+
+    const int ix0 = CellX(box.x_min);
+    const int ix1 = CellX(box.x_max);
+    const int iy0 = CellY(box.y_min);
+    const int iy1 = CellY(box.y_max);
+
+    for (int iy = iy0; iy <= iy1; iy++) {
+      for (int ix = ix0; ix <= ix1; ix++) {
+        cell_indexes_[positions[iy * num_cells_x_ + ix]++] = i;
+      }
+    }
+  }
+}
+
+void SpatialIndex2d::Clear() {
+  boxes_.clear();
+  cell_offsets_.clear();
+  cell_indexes_.clear();
+  indexes_oversized_.clear();
+
+  extents_.x_max = -999999;
+  extents_.x_min = 999999;
+  extents_.y_max = -999999;
+  extents_.y_min = 999999;
+
+  num_cells_x_ = 0;
+  num_cells_y_ = 0;
+  size_cell_x_ = 0;
+  size_cell_y_ = 0;
+}
+
+void SpatialIndex2d::Query(const BoundingBox2d& region,
+                           std::vector<unsigned int>& indexes) const {
+  indexes.clear();
+
+  // checks if any elements exist
+  if (boxes_.empty() == true) {
+    return;
+  }
+
+  // checks if the region overlaps the extents
+  if ((region.x_max < extents_.x_min) || (extents_.x_max < region.x_min)
+      || (region.y_max < extents_.y_min) || (extents_.y_max < region.y_min)) {
+    return;
+  }
+
+  // searches the cells that overlap the region
+  const int ix0 = CellX(region.x_min);
+  const int ix1 = CellX(region.x_max);
+  const int iy0 = CellY(region.y_min);
+  const int iy1 = CellY(region.y_max);
+
+  for (int iy = iy0; iy <= iy1; iy++) {
+    for (int ix = ix0; ix <= ix1; ix++) {
+      const std::size_t kIndexCell = iy * num_cells_x_ + ix;
+      for (unsigned int k = cell_offsets_[kIndexCell];
+           k < cell_offsets_[kIndexCell + 1]; k++) {
+        const unsigned int index = cell_indexes_[k];
+        const BoundingBox2d& box = boxes_[index];
+
+        // skips elements that do not intersect the region
+        if ((box.x_max < region.x_min) || (region.x_max < box.x_min)
+            || (box.y_max < region.y_min) || (region.y_max < box.y_min)) {
+          continue;
+        }
+
+        // skips elements that are reported from another cell
+        if ((std::max(CellX(box.x_min), ix0) != ix)
+            || (std::max(CellY(box.y_min), iy0) != iy)) {
+          continue;
+        }
+
+        indexes.push_back(index);
+      }
+    }
+  }
+
+  // searches the oversized elements
+  for (auto iter = indexes_oversized_.cbegin();
+       iter != indexes_oversized_.cend(); iter++) {
+    const unsigned int index = *iter;
+    const BoundingBox2d& box = boxes_[index];
+
+    if ((box.x_max < region.x_min) || (region.x_max < box.x_min)
+        || (box.y_max < region.y_min) || (region.y_max < box.y_min)) {
+      continue;
+    }
+
+    indexes.push_back(index);
+  }
+
+  // sorts to keep the dataset draw order
+  std::sort(indexes.begin(), indexes.end());
+}
+
+std::size_t SpatialIndex2d::Size() const {
+  return boxes_.size();
+}
+
+int SpatialIndex2d::CellX(const float& x) const {
+  if (size_cell_x_ <= 0) {
+    return 0;
+  }
+
+  // clamps before converting to avoid overflowing the integer
+  const float index = (x - extents_.x_min) / size_cell_x_;
+  if (index < 0) {
+    return 0;
+  } else if (num_cells_x_ <= index) {
+    return num_cells_x_ - 1;
+  } else {
+    return static_cast<int>(index);
+  }
+}
+
+int SpatialIndex2d::CellY(const float& y) const {
+  if (size_cell_y_ <= 0) {
+    return 0;
+  }
+
+  // clamps before converting to avoid overflowing the integer
+  const float index = (y - extents_.y_min) / size_cell_y_;
+  if (index < 0) {
+    return 0;
+  } else if (num_cells_y_ <= index) {
+    return num_cells_y_ - 1;
+  } else {
+    return static_cast<int>(index);
+  }
+}
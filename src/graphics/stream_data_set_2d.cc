@@ -0,0 +1,174 @@
+// This is free and unencumbered software released into the public domain.
+// For more information, please refer to <http://unlicense.org/>
+
+#include "appcommon/graphics/stream_data_set_2d.h"
+
+#include <algorithm>
+
+StreamDataSet2d::StreamDataSet2d(const std::size_t& capacity) {
+  capacity_ = std::max(capacity, static_cast<std::size_t>(1));
+
+  x_.resize(capacity_);
+  y_.resize(capacity_);
+
+  index_head_ = 0;
+  sequence_ = 0;
+  size_ = 0;
+}
+
+StreamDataSet2d::~StreamDataSet2d() {
+}
+
+void StreamDataSet2d::Add(const float& x, const float& y) {
+  // evicts the oldest sample if the buffer is full
+  if (size_ == capacity_) {
+    const uint64_t sequence_oldest = sequence_ - size_;
+    Pop(sequence_oldest, extents_x_max_);
+    Pop(sequence_oldest, extents_x_min_);
+    Pop(sequence_oldest, extents_y_max_);
+    Pop(sequence_oldest, extents_y_min_);
+  } else {
+    size_++;
+  }
+
+  // stores the sample, overwriting the oldest
+  x_[index_head_] = x;
+  y_[index_head_] = y;
+  index_head_ = (index_head_ + 1) % capacity_;
+
+  PushMax(sequence_, x, extents_x_max_);
+  PushMin(sequence_, x, extents_x_min_);
+  PushMax(sequence_, y, extents_y_max_);
+  PushMin(sequence_, y, extents_y_min_);
+
+  sequence_++;
+  version_++;
+}
+
+void StreamDataSet2d::Clear() {
+  extents_x_max_.clear();
+  extents_x_min_.clear();
+  extents_y_max_.clear();
+  extents_y_min_.clear();
+
+  index_head_ = 0;
+  size_ = 0;
+
+  ResetLimits();
+  version_++;
+}
+
+float StreamDataSet2d::MaxX() const {
+  if (extents_x_max_.empty() == true) {
+    return x_max_;
+  }
+
+  return extents_x_max_.front().value;
+}
+
+float StreamDataSet2d::MaxY() const {
+  if (extents_y_max_.empty() == true) {
+    return y_max_;
+  }
+
+  return extents_y_max_.front().value;
+}
+
+float StreamDataSet2d::MinX() const {
+  if (extents_x_min_.empty() == true) {
+    return x_min_;
+  }
+
+  return extents_x_min_.front().value;
+}
+
+float StreamDataSet2d::MinY() const {
+  if (extents_y_min_.empty() == true) {
+    return y_min_;
+  }
+
+  return extents_y_min_.front().value;
+}
+
+bool StreamDataSet2d::Nearest(const Point2d<float>& point,
+                              const float& scale_x, const float& scale_y,
+                              const float& radius, unsigned int& index,
+                              float& distance) const {
+  // solves for the buffer index of the oldest sample
+  const std::size_t index_tail = (index_head_ + capacity_ - size_) % capacity_;
+
+  // searches every segment, as the stream is not indexed
+  // newer segments are drawn on top, so they are preferred on ties
+  bool is_found = false;
+  distance = radius;
+  for (std::size_t i = 0; i + 1 < size_; i++) {
+    const std::size_t k0 = (index_tail + i) % capacity_;
+    const std::size_t k1 = (index_tail + i + 1) % capacity_;
+    const float d = DistanceSegment(point, x_[k0], y_[k0], x_[k1], y_[k1],
+                                    scale_x, scale_y);
+
+    if (d <= distance) {
+      distance = d;
+      index = i;
+      is_found = true;
+    }
+  }
+
+  return is_found;
+}
+
+std::size_t StreamDataSet2d::Size() const {
+  return size_;
+}
+
+StreamDataSpan2d StreamDataSet2d::Span() const {
+  // solves for the buffer index of the oldest sample
+  const std::size_t index_tail = (index_head_ + capacity_ - size_) % capacity_;
+
+  StreamDataSpan2d span;
+  span.size_first = std::min(size_, capacity_ - index_tail);
+  span.size_second = size_ - span.size_first;
+  span.x_first = x_.data() + index_tail;
+  span.x_second = x_.data();
+  span.y_first = y_.data() + index_tail;
+  span.y_second = y_.data();
+
+  return span;
+}
+
+std::size_t StreamDataSet2d::capacity() const {
+  return capacity_;
+}
+
+void StreamDataSet2d::PushMax(const uint64_t& sequence, const float& value,
+                              std::deque<StreamExtent2d>& extents) {
+  // removes values that can no longer be the maximum
+  while ((extents.empty() == false) && (extents.back().value <= value)) {
+    extents.pop_back();
+  }
+
+  StreamExtent2d extent;
+  extent.sequence = sequence;
+  extent.value = value;
+  extents.push_back(extent);
+}
+
+void StreamDataSet2d::PushMin(const uint64_t& sequence, const float& value,
+                              std::deque<StreamExtent2d>& extents) {
+  // removes values that can no longer be the minimum
+  while ((extents.empty() == false) && (value <= extents.back().value)) {
+    extents.pop_back();
+  }
+
+  StreamExtent2d extent;
+  extent.sequence = sequence;
+  extent.value = value;
+  extents.push_back(extent);
+}
+
+void StreamDataSet2d::Pop(const uint64_t& sequence,
+                          std::deque<StreamExtent2d>& extents) {
+  if ((extents.empty() == false) && (extents.front().sequence == sequence)) {
+    extents.pop_front();
+  }
+}
@@ -0,0 +1,107 @@
+// This is free and unencumbered software released into the public domain.
+// For more information, please refer to <http://unlicense.org/>
+
+#include "appcommon/graphics/stream_renderer_2d.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "appcommon/graphics/graphics_kernel_2d.h"
+
+StreamRenderer2d::StreamRenderer2d() {
+  pen_ = nullptr;
+}
+
+Renderer2d* StreamRenderer2d::Clone() const {
+  StreamRenderer2d* renderer = new StreamRenderer2d(*this);
+  renderer->pen_ = renderer->CopyStyle(pen_);
+
+  return renderer;
+}
+
+void StreamRenderer2d::Draw(wxDC& dc, wxRect rc,
+                            const PlotAxis& axis_horizontal,
+                            const PlotAxis& axis_vertical) const {
+  // sets drawing pen
+  if ((always_contrast_background_ == true)
+       && (pen_->GetColour() == dc.GetBackground().GetColour())) {
+    // gets the inverse color
+    wxColour color_inverse = InvertColor(pen_->GetColour());
+
+    // creates a new pen with the inverted color
+    wxPen pen = *pen_;
+    pen.SetColour(color_inverse);
+
+    // updates dc with inverted pen
+    dc.SetPen(pen);
+  } else {
+    // updates dc with typical pen
+    dc.SetPen(*pen_);
+  }
+
+  // transforms and clips the segments between consecutive samples
+  std::vector<wxPoint> points;
+  TransformStream(rc, axis_horizontal, axis_vertical, points);
+
+  // updates the statistics
+  // the samples are connected by one less segment than there are samples
+  statistics_.count_drawn = points.size() / 2;
+  statistics_.count_total =
+      std::max(dataset()->Size(), static_cast<std::size_t>(1)) - 1;
+
+  // draws onto DC
+  DrawSegments(dc, points);
+}
+
+void StreamRenderer2d::Export(wxDC& dc, SvgWriter2d& writer, wxRect rc,
+                              const PlotAxis& axis_horizontal,
+                              const PlotAxis& axis_vertical) const {
+  // sets the style
+  const wxPen pen = PenContrasted(*pen_, dc.GetBackground().GetColour());
+  writer.SetStyle(&pen, nullptr);
+
+  // transforms the samples and writes the visible runs
+  std::vector<wxRealPoint> points;
+  TransformStream(rc, axis_horizontal, axis_vertical, points);
+  writer.WriteSegments(points);
+}
+
+const wxPen* StreamRenderer2d::pen() const {
+  return pen_;
+}
+
+void StreamRenderer2d::set_pen(const wxPen* pen) {
+  pen_ = pen;
+}
+
+template <typename T>
+void StreamRenderer2d::TransformStream(const wxRect& rc,
+                                       const PlotAxis& axis_horizontal,
+                                       const PlotAxis& axis_vertical,
+                                       std::vector<T>& points) const {
+  // gets the typed stream dataset
+  const StreamDataSet2d* dataset = this->dataset();
+  const StreamDataSpan2d data = dataset->Span();
+
+  // transforms and clips the segments between consecutive samples
+  // each part of the ring buffer is contiguous, so its segments are the
+  // sample arrays offset by one
+  const GraphicsKernel2d kernel(axis_horizontal, axis_vertical, rc);
+  points.clear();
+  if (2 <= data.size_first) {
+    kernel.ClipSegments(data.x_first, data.y_first,
+                        data.x_first + 1, data.y_first + 1,
+                        data.size_first - 1, points);
+  }
+
+  if (1 <= data.size_second) {
+    // connects the end of the first part to the start of the second part
+    kernel.ClipSegments(data.x_first + data.size_first - 1,
+                        data.y_first + data.size_first - 1,
+                        data.x_second, data.y_second, 1, points);
+
+    kernel.ClipSegments(data.x_second, data.y_second,
+                        data.x_second + 1, data.y_second + 1,
+                        data.size_second - 1, points);
+  }
+}
@@ -0,0 +1,341 @@
+// This is free and unencumbered software released into the public domain.
+// For more information, please refer to <http://unlicense.org/>
+
+#include "appcommon/graphics/svg_writer_2d.h"
+
+#include <algorithm>
+#include <cinttypes>
+#include <cmath>
+
+namespace {
+
+/// The number of coordinate steps in a graphics unit. Coordinates are rounded
+/// to a step, which is well below what is visible.
+const int kNumStepsUnit = 100;
+
+/// \brief Rounds a coordinate to a number of steps.
+/// \param[in] value
+///   The coordinate, in graphics units.
+/// \return The number of steps.
+int64_t Steps(const double& value) {
+  return static_cast<int64_t>(std::llround(value * kNumStepsUnit));
+}
+
+}  // namespace
+
+SvgWriter2d::SvgWriter2d() {
+  file_ = nullptr;
+  is_group_ = false;
+}
+
+SvgWriter2d::~SvgWriter2d() {
+  Close();
+}
+
+bool SvgWriter2d::Close() {
+  if (file_ == nullptr) {
+    return false;
+  }
+
+  // finishes the document
+  if (is_group_ == true) {
+    std::fputs("</g>\n", file_);
+  }
+  std::fputs("</svg>\n", file_);
+
+  // checks for write errors before closing
+  const bool is_error = (std::ferror(file_) != 0);
+  const bool is_closed = (std::fclose(file_) == 0);
+
+  file_ = nullptr;
+  is_group_ = false;
+  style_.clear();
+
+  return (is_error == false) && (is_closed == true);
+}
+
+bool SvgWriter2d::IsOpen() const {
+  return file_ != nullptr;
+}
+
+bool SvgWriter2d::Open(const std::string& filename, const int& width,
+                       const int& height, const wxColour& background) {
+  Close();
+
+  file_ = std::fopen(filename.c_str(), "wb");
+  if (file_ == nullptr) {
+    return false;
+  }
+
+  // writes the header and fills the background
+  std::fputs("<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"no\"?>\n",
+             file_);
+  std::fprintf(file_,
+               "<svg xmlns=\"http://www.w3.org/2000/svg\" version=\"1.1\" "
+               "width=\"%d\" height=\"%d\" viewBox=\"0 0 %d %d\">\n",
+               width, height, width, height);
+  std::fprintf(file_, "<rect width=\"%d\" height=\"%d\"%s/>\n", width, height,
+               Paint("fill", background).c_str());
+
+  return true;
+}
+
+void SvgWriter2d::SetStyle(const wxPen* pen, const wxBrush* brush) {
+  std::string style;
+
+  // formats the pen
+  if ((pen == nullptr) || (pen->IsOk() == false)
+      || (pen->GetStyle() == wxPENSTYLE_TRANSPARENT)) {
+    style += " stroke=\"none\"";
+  } else {
+    const int width = std::max(pen->GetWidth(), 1);
+    style += Paint("stroke", pen->GetColour());
+    style += " stroke-width=\"" + std::to_string(width) + "\"";
+
+    if (pen->GetCap() == wxCAP_BUTT) {
+      style += " stroke-linecap=\"butt\"";
+    } else if (pen->GetCap() == wxCAP_PROJECTING) {
+      style += " stroke-linecap=\"square\"";
+    } else {
+      style += " stroke-linecap=\"round\"";
+    }
+
+    if (pen->GetJoin() == wxJOIN_BEVEL) {
+      style += " stroke-linejoin=\"bevel\"";
+    } else if (pen->GetJoin() == wxJOIN_MITER) {
+      style += " stroke-linejoin=\"miter\"";
+    } else {
+      style += " stroke-linejoin=\"round\"";
+    }
+
+    // the dash lengths are scaled by the pen width, similar to wxWidgets
+    const std::string dash = std::to_string(3 * width);
+    const std::string dot = std::to_string(width);
+    const std::string gap = std::to_string(2 * width);
+    if (pen->GetStyle() == wxPENSTYLE_DOT) {
+      style += " stroke-dasharray=\"" + dot + " " + gap + "\"";
+    } else if (pen->GetStyle() == wxPENSTYLE_LONG_DASH) {
+      style += " stroke-dasharray=\"" + std::to_string(6 * width) + " " + gap
+               + "\"";
+    } else if (pen->GetStyle() == wxPENSTYLE_SHORT_DASH) {
+      style += " stroke-dasharray=\"" + dash + " " + gap + "\"";
+    } else if (pen->GetStyle() == wxPENSTYLE_DOT_DASH) {
+      style += " stroke-dasharray=\"" + dash + " " + gap + " " + dot + " "
+               + gap + "\"";
+    }
+  }
+
+  // formats the brush
+  if ((brush == nullptr) || (brush->IsOk() == false)
+      || (brush->GetStyle() == wxBRUSHSTYLE_TRANSPARENT)) {
+    style += " fill=\"none\"";
+  } else {
+    style += Paint("fill", brush->GetColour());
+  }
+
+  UpdateGroup(style);
+}
+
+void SvgWriter2d::SetStyleText(const wxColour& colour, const wxFont& font) {
+  std::string style;
+  style += Paint("fill", colour);
+  style += " stroke=\"none\"";
+
+  // formats the font
+  // the text is positioned from its upper left corner, like a device context
+  const std::string face(font.GetFaceName().utf8_str());
+  if (face.empty() == false) {
+    style += " font-family=\"" + Escape(face) + "\"";
+  }
+
+  style += " font-size=\"" + std::to_string(font.GetPointSize()) + "pt\"";
+
+  if (font.GetWeight() == wxFONTWEIGHT_BOLD) {
+    style += " font-weight=\"bold\"";
+  }
+
+  if (font.GetStyle() == wxFONTSTYLE_ITALIC) {
+    style += " font-style=\"italic\"";
+  }
+
+  style += " dominant-baseline=\"text-before-edge\"";
+
+  UpdateGroup(style);
+}
+
+void SvgWriter2d::WriteCircle(const wxRealPoint& center,
+                              const double& radius) {
+  if (file_ == nullptr) {
+    return;
+  }
+
+  std::fputs("<circle cx=\"", file_);
+  WriteSteps(Steps(center.x));
+  std::fputs("\" cy=\"", file_);
+  WriteSteps(Steps(center.y));
+  std::fputs("\" r=\"", file_);
+  WriteSteps(Steps(radius));
+  std::fputs("\"/>\n", file_);
+}
+
+void SvgWriter2d::WritePoints(const std::vector<wxRealPoint>& points) {
+  if ((file_ == nullptr) || (points.empty() == true)) {
+    return;
+  }
+
+  std::fputs("<path d=\"", file_);
+  for (auto iter = points.cbegin(); iter != points.cend(); iter++) {
+    std::fputc('M', file_);
+    WriteSteps(Steps(iter->x));
+    std::fputc(' ', file_);
+    WriteSteps(Steps(iter->y));
+    std::fputs("h1", file_);
+  }
+  std::fputs("\"/>\n", file_);
+}
+
+void SvgWriter2d::WriteSegments(const std::vector<wxRealPoint>& points) {
+  // checks if any segments exist
+  if ((file_ == nullptr) || (points.size() < 2)) {
+    return;
+  }
+
+  // writes all segments as one path, starting a new run only when a segment
+  // does not continue the previous one
+  // the points are compared and differenced after rounding, so the relative
+  // coordinates land exactly on each rounded point
+  std::fputs("<path d=\"", file_);
+  int64_t x_previous = 0;
+  int64_t y_previous = 0;
+  for (std::size_t i = 0; i + 1 < points.size(); i += 2) {
+    const int64_t x0 = Steps(points[i].x);
+    const int64_t y0 = Steps(points[i].y);
+    const int64_t x1 = Steps(points[i + 1].x);
+    const int64_t y1 = Steps(points[i + 1].y);
+
+    if ((i == 0) || (x0 != x_previous) || (y0 != y_previous)) {
+      if (i != 0) {
+        std::fputc('\n', file_);
+      }
+      std::fputc('M', file_);
+      WriteSteps(x0);
+      std::fputc(' ', file_);
+      WriteSteps(y0);
+    }
+
+    std::fputc('l', file_);
+    WriteSteps(x1 - x0);
+    std::fputc(' ', file_);
+    WriteSteps(y1 - y0);
+
+    x_previous = x1;
+    y_previous = y1;
+  }
+  std::fputs("\"/>\n", file_);
+}
+
+void SvgWriter2d::WriteText(const std::string& message,
+                            const wxRealPoint& point, const float& angle) {
+  if (file_ == nullptr) {
+    return;
+  }
+
+  std::fputs("<text x=\"", file_);
+  WriteSteps(Steps(point.x));
+  std::fputs("\" y=\"", file_);
+  WriteSteps(Steps(point.y));
+  std::fputc('"', file_);
+
+  // svg rotates clockwise, as the graphics y-axis is inverted
+  // the angle is written as steps, so the decimal point does not depend on
+  // the locale
+  if (angle != 0) {
+    std::fputs(" transform=\"rotate(", file_);
+    WriteSteps(Steps(-angle));
+    std::fputc(' ', file_);
+    WriteSteps(Steps(point.x));
+    std::fputc(' ', file_);
+    WriteSteps(Steps(point.y));
+    std::fputs(")\"", file_);
+  }
+
+  std::fprintf(file_, ">%s</text>\n", Escape(message).c_str());
+}
+
+std::string SvgWriter2d::Escape(const std::string& str) {
+  std::string escaped;
+  escaped.reserve(str.size());
+
+  for (auto iter = str.cbegin(); iter != str.cend(); iter++) {
+    const char c = *iter;
+    if (c == '&') {
+      escaped += "&amp;";
+    } else if (c == '<') {
+      escaped += "&lt;";
+    } else if (c == '>') {
+      escaped += "&gt;";
+    } else if (c == '"') {
+      escaped += "&quot;";
+    } else {
+      escaped += c;
+    }
+  }
+
+  return escaped;
+}
+
+std::string SvgWriter2d::Paint(const std::string& name,
+                               const wxColour& colour) {
+  char buffer[64];
+  std::snprintf(buffer, sizeof(buffer), " %s=\"#%02x%02x%02x\"", name.c_str(),
+                colour.Red(), colour.Green(), colour.Blue());
+
+  std::string paint(buffer);
+
+  // adds the opacity if the colour is translucent
+  // the opacity is below one, so it is written as integer thousandths, which
+  // do not depend on the locale
+  if (colour.Alpha() < wxALPHA_OPAQUE) {
+    const int thousandths = static_cast<int>(
+        std::lround(colour.Alpha() * 1000 / 255.0));
+    std::snprintf(buffer, sizeof(buffer), " %s-opacity=\"0.%03d\"",
+                  name.c_str(), thousandths);
+    paint += buffer;
+  }
+
+  return paint;
+}
+
+void SvgWriter2d::UpdateGroup(const std::string& style) {
+  if ((file_ == nullptr)
+      || ((is_group_ == true) && (style == style_))) {
+    return;
+  }
+
+  // closes the previous group and starts a group with the new style
+  if (is_group_ == true) {
+    std::fputs("</g>\n", file_);
+  }
+  std::fprintf(file_, "<g%s>\n", style.c_str());
+
+  is_group_ = true;
+  style_ = style;
+}
+
+void SvgWriter2d::WriteSteps(const int64_t& steps) {
+  // writes the whole units, keeping the sign for values between -1 and 0
+  const int64_t steps_abs = (steps < 0) ? -steps : steps;
+  const int64_t units = steps_abs / kNumStepsUnit;
+  const int fraction = static_cast<int>(steps_abs % kNumStepsUnit);
+
+  std::fprintf(file_, "%s%" PRId64, (steps < 0) ? "-" : "", units);
+
+  // writes the fraction without trailing zeros
+  if (fraction == 0) {
+    return;
+  } else if (fraction % 10 == 0) {
+    std::fprintf(file_, ".%d", fraction / 10);
+  } else {
+    std::fprintf(file_, ".%02d", fraction);
+  }
+}
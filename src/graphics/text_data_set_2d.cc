@@ -4,9 +4,10 @@
 #include "appcommon/graphics/text_data_set_2d.h"
 
 #include <algorithm>
+#include <cmath>
 
 TextDataSet2d::TextDataSet2d() {
-  is_updated_ = false;
+  is_updated_data_ = false;
 }
 
 TextDataSet2d::~TextDataSet2d() {
@@ -14,80 +15,121 @@ TextDataSet2d::~TextDataSet2d() {
 }
 
 void TextDataSet2d::Add(const Text2d* text) {
-  data_.push_back(text);
+  // keeps the pointer, which is deleted when the dataset is cleared
+  pointers_.push_back(text);
+  AddElement(text);
+}
 
-  is_updated_ = false;
+void TextDataSet2d::Add(const Text2d& text) {
+  AddElement(arena_.Emplace(text));
 }
 
 void TextDataSet2d::Clear() {
-  for (auto iter = data_.begin(); iter != data_.end(); iter++) {
-    const Text2d* text = *iter;
-    delete text;
+  for (auto iter = pointers_.begin(); iter != pointers_.end(); iter++) {
+    delete *iter;
   }
 
+  pointers_.clear();
+  elements_.clear();
+  arena_.Clear();
   data_.clear();
 
-  is_updated_ = false;
+  ResetLimits();
+  version_++;
+
+  is_updated_data_ = false;
+  is_updated_index_ = false;
 }
 
 float TextDataSet2d::MaxX() const {
-  if (is_updated_ == false) {
-    Update();
-  }
-
   return x_max_;
 }
 
 float TextDataSet2d::MaxY() const {
-  if (is_updated_ == false) {
-    Update();
-  }
-
   return y_max_;
 }
 
 float TextDataSet2d::MinX() const {
-  if (is_updated_ == false) {
-    Update();
-  }
-
   return x_min_;
 }
 
 float TextDataSet2d::MinY() const {
-  if (is_updated_ == false) {
-    Update();
+  return y_min_;
+}
+
+bool TextDataSet2d::Nearest(const Point2d<float>& point, const float& scale_x,
+                            const float& scale_y, const float& radius,
+                            unsigned int& index, float& distance) const {
+  // gets the candidate elements
+  // every element is checked if the dataset does not build an index
+  std::vector<unsigned int> indexes;
+  const bool is_queried = IndexesPick(point, scale_x, scale_y, radius,
+                                      indexes);
+
+  // searches for the nearest element
+  // later elements are drawn on top, so they are preferred on ties
+  bool is_found = false;
+  distance = radius;
+  const std::size_t size = (is_queried == true) ? indexes.size()
+                                                : elements_.size();
+  for (std::size_t j = 0; j < size; j++) {
+    const unsigned int i = (is_queried == true) ? indexes[j] : j;
+    const Text2d* text = elements_[i];
+    const float d = std::hypot((text->point.x - point.x) * scale_x,
+                               (text->point.y - point.y) * scale_y);
+
+    if (d <= distance) {
+      distance = d;
+      index = i;
+      is_found = true;
+    }
   }
 
-  return y_min_;
+  return is_found;
+}
+
+std::size_t TextDataSet2d::Size() const {
+  return elements_.size();
 }
 
 const std::list<const Text2d*>* TextDataSet2d::data() const {
+  if (is_updated_data_ == false) {
+    data_.assign(elements_.cbegin(), elements_.cend());
+    is_updated_data_ = true;
+  }
+
   return &data_;
 }
 
-void TextDataSet2d::Update() const {
-  // initializes
-  x_min_ = 999999;
-  x_max_ = -999999;
+const std::vector<const Text2d*>* TextDataSet2d::elements() const {
+  return &elements_;
+}
 
-  y_min_ = 999999;
-  y_max_ = -999999;
+void TextDataSet2d::AddElement(const Text2d* text) {
+  elements_.push_back(text);
 
-  // checks if data exists, exits if not
-  if (data_.empty() == true) {
-    return;
-  }
+  ExtendLimits(text->point.x, text->point.y);
+  version_++;
 
-  for (auto iter = data_.cbegin(); iter != data_.cend(); iter++) {
-    const Text2d* text = *iter;
+  is_updated_data_ = false;
+  is_updated_index_ = false;
+}
 
-    x_min_ = std::min(text->point.x, x_min_);
-    x_max_ = std::max(text->point.x, x_max_);
+bool TextDataSet2d::UpdateIndex() const {
+  std::vector<BoundingBox2d> boxes;
+  boxes.reserve(elements_.size());
+  for (auto iter = elements_.cbegin(); iter != elements_.cend(); iter++) {
+    const Text2d* text = *iter;
 
-    y_min_ = std::min(text->point.y, y_min_);
-    y_max_ = std::max(text->point.y, y_max_);
+    BoundingBox2d box;
+    box.x_min = text->point.x;
+    box.x_max = text->point.x;
+    box.y_min = text->point.y;
+    box.y_max = text->point.y;
+    boxes.push_back(box);
   }
 
-  is_updated_ = true;
+  index_.Build(boxes);
+
+  return true;
 }
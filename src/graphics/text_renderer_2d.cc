@@ -3,63 +3,329 @@
 
 #include "appcommon/graphics/text_renderer_2d.h"
 
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
 #include "models/base/vector.h"
+#include "wx/graphics.h"
+#include "wx/math.h"
+
+#include "appcommon/graphics/graphics_kernel_2d.h"
+
+namespace {
+
+/// The maximum number of cached labels. The cache is cleared when this is
+/// exceeded, which bounds the memory used by labels that are no longer drawn.
+const std::size_t kNumLabelsMax = 16384;
+
+/// The size (in graphics units) of the declutter occupancy grid cells.
+const int kSizeCellDeclutter = 64;
+
+}  // namespace
 
 TextRenderer2d::TextRenderer2d() {
   color_ = nullptr;
+  is_decluttered_ = false;
+  is_rasterized_ = false;
+}
+
+Renderer2d* TextRenderer2d::Clone() const {
+  TextRenderer2d* renderer = new TextRenderer2d(*this);
+  renderer->color_ = renderer->CopyStyle(color_);
+
+  // the cached labels and colour share data with the original
+  renderer->color_cache_ = wxColour();
+  renderer->labels_.clear();
+
+  // the clone may draw on another thread, where labels cannot be rasterized
+  renderer->is_rasterized_ = false;
+
+  return renderer;
 }
 
 void TextRenderer2d::Draw(wxDC& dc, wxRect rc, const PlotAxis& axis_horizontal,
                           const PlotAxis& axis_vertical) const {
   // sets text colors for dc
   dc.SetBackgroundMode(wxPENSTYLE_TRANSPARENT);
+  wxColour color = *color_;
   if ((always_contrast_background_ == true)
        && (*color_ == dc.GetBackground().GetColour())) {
     // gets the inverse color
-    wxColour color_inverse = InvertColor(*color_);
+    color = InvertColor(*color_);
+  }
+
+  dc.SetTextForeground(color);
 
-    // updates dc with inverted color
-    dc.SetTextForeground(color_inverse);
+  // transforms the visible text, reusing the cached coordinates if possible
+  std::vector<wxPoint> points;
+  std::vector<unsigned int> indexes;
+  if (is_cached_ == true) {
+    if (cache_.IsValid(axis_horizontal, axis_vertical, rc,
+                       dataset_->version()) == false) {
+      PlotAxis axis_horizontal_cache;
+      PlotAxis axis_vertical_cache;
+      wxRect rc_cache;
+      VertexCache2d::Region(axis_horizontal, axis_vertical, rc,
+                            axis_horizontal_cache, axis_vertical_cache,
+                            rc_cache);
+
+      std::vector<wxPoint> points_cache;
+      std::vector<unsigned int> indexes_cache;
+      TransformText(rc_cache, axis_horizontal_cache, axis_vertical_cache,
+                    points_cache, indexes_cache);
+      cache_.Update(axis_horizontal, axis_vertical, rc, axis_horizontal_cache,
+                    axis_vertical_cache, dataset_->version(), 0,
+                    points_cache, indexes_cache);
+    }
+
+    cache_.Points(axis_horizontal, axis_vertical, rc, points, indexes);
   } else {
-    // updates dc with typical color
-    dc.SetTextForeground(*color_);
+    TransformText(rc, axis_horizontal, axis_vertical, points, indexes);
   }
 
-  // casts to text dataset
-  const TextDataSet2d* dataset = dynamic_cast<const TextDataSet2d*>(dataset_);
+  // positions each visible text
+  std::vector<TextLabelPosition2d> labels;
+  PositionLabels(dc, color, points, indexes, labels);
 
-  // draws each text in dataset
-  const std::list<const Text2d*>* data = dataset->data();
-  for (auto iter = data->cbegin(); iter != data->cend(); iter++) {
-    // gets text
-    const Text2d* text = *iter;
+  // removes colliding labels
+  if (is_decluttered_ == true) {
+    Declutter(rc, labels);
+  }
 
-    // gets points to draw
-    const float& x = text->point.x;
-    const float& y = text->point.y;
+  // updates the statistics
+  statistics_.count_drawn = labels.size();
+  statistics_.count_total = dataset()->Size();
 
-    // skips points that are out of range
-    if (x < axis_horizontal.Min()) {
-      continue;
-    } else if (axis_horizontal.Max() < x) {
-      continue;
-    } else if (y < axis_vertical.Min()) {
-      continue;
-    } else if (axis_vertical.Max() < y) {
+  // draws onto DC
+  for (auto iter = labels.cbegin(); iter != labels.cend(); iter++) {
+    const TextLabelPosition2d& position = *iter;
+    const TextLabel2d& label = *position.label;
+
+    if (label.bitmap.IsOk() == true) {
+      dc.DrawBitmap(label.bitmap, position.point.x + label.origin.x,
+                    position.point.y + label.origin.y, true);
+    } else {
+      dc.DrawRotatedText(position.text->message, position.point.x,
+                         position.point.y, position.text->angle);
+    }
+  }
+}
+
+void TextRenderer2d::Export(wxDC& dc, SvgWriter2d& writer, wxRect rc,
+                            const PlotAxis& axis_horizontal,
+                            const PlotAxis& axis_vertical) const {
+  // sets the style
+  wxColour color = *color_;
+  if ((always_contrast_background_ == true)
+       && (*color_ == dc.GetBackground().GetColour())) {
+    // gets the inverse color
+    color = InvertColor(*color_);
+  }
+
+  writer.SetStyleText(color, dc.GetFont());
+
+  // transforms and positions the visible text
+  std::vector<wxRealPoint> points;
+  std::vector<unsigned int> indexes;
+  TransformText(rc, axis_horizontal, axis_vertical, points, indexes);
+
+  std::vector<TextLabelPosition2d> labels;
+  PositionLabels(dc, color, points, indexes, labels);
+
+  // removes colliding labels
+  if (is_decluttered_ == true) {
+    Declutter(rc, labels);
+  }
+
+  // writes each label as text, even if it is rasterized for drawing
+  for (auto iter = labels.cbegin(); iter != labels.cend(); iter++) {
+    const TextLabelPosition2d& position = *iter;
+    writer.WriteText(position.text->message, position.point_exact,
+                     position.text->angle);
+  }
+}
+
+const wxColour* TextRenderer2d::color() const {
+  return color_;
+}
+
+bool TextRenderer2d::is_decluttered() const {
+  return is_decluttered_;
+}
+
+bool TextRenderer2d::is_rasterized() const {
+  return is_rasterized_;
+}
+
+void TextRenderer2d::set_color(const wxColour* color) {
+  color_ = color;
+}
+
+void TextRenderer2d::set_is_decluttered(const bool& is_decluttered) {
+  is_decluttered_ = is_decluttered;
+}
+
+void TextRenderer2d::set_is_rasterized(const bool& is_rasterized) {
+  is_rasterized_ = is_rasterized;
+  labels_.clear();
+}
+
+const TextLabel2d& TextRenderer2d::Label(wxDC& dc, const Text2d& text,
+                                         const wxColour& color) const {
+  // searches the cache
+  const std::pair<std::string, float> key(text.message, text.angle);
+  auto iter = labels_.find(key);
+  if (iter != labels_.end()) {
+    return iter->second;
+  }
+
+  // measures the text
+  TextLabel2d label;
+  label.size = dc.GetTextExtent(text.message);
+
+  // solves for the rotated bounding box relative to the text origin
+  // the graphics y-axis is inverted, so a counter-clockwise rotation uses the
+  // negative sine
+  const double kAngle = wxDegToRad(text.angle);
+  const double kCos = std::cos(kAngle);
+  const double kSin = std::sin(kAngle);
+  const double kCornersX[4] = {0, 1, 0, 1};
+  const double kCornersY[4] = {0, 0, 1, 1};
+
+  double x_min = 0;
+  double x_max = 0;
+  double y_min = 0;
+  double y_max = 0;
+  for (int i = 0; i < 4; i++) {
+    const double x = kCornersX[i] * label.size.GetWidth();
+    const double y = kCornersY[i] * label.size.GetHeight();
+    const double xr = x * kCos + y * kSin;
+    const double yr = -x * kSin + y * kCos;
+
+    x_min = std::min(x_min, xr);
+    x_max = std::max(x_max, xr);
+    y_min = std::min(y_min, yr);
+    y_max = std::max(y_max, yr);
+  }
+
+  label.origin.x = static_cast<int>(std::floor(x_min));
+  label.origin.y = static_cast<int>(std::floor(y_min));
+  label.size_rotated.x = static_cast<int>(std::ceil(x_max))
+                         - label.origin.x + 1;
+  label.size_rotated.y = static_cast<int>(std::ceil(y_max))
+                         - label.origin.y + 1;
+
+  // rasterizes and caches the label
+  if (is_rasterized_ == true) {
+    RasterizeLabel(dc, text, color, label);
+  }
+
+  return labels_.insert(std::make_pair(key, label)).first->second;
+}
+
+void TextRenderer2d::Declutter(const wxRect& rc,
+                               std::vector<TextLabelPosition2d>& labels) {
+  // orders the labels by descending priority, keeping the dataset order for
+  // equal priorities
+  std::stable_sort(labels.begin(), labels.end(),
+                   [](const TextLabelPosition2d& label_a,
+                      const TextLabelPosition2d& label_b) {
+    return label_b.text->priority < label_a.text->priority;
+  });
+
+  // initializes the occupancy grid, with a border of one cell so labels that
+  // are partially outside the region still collide
+  const int kNumCellsX = rc.GetWidth() / kSizeCellDeclutter + 3;
+  const int kNumCellsY = rc.GetHeight() / kSizeCellDeclutter + 3;
+  std::vector<std::vector<unsigned int>> cells(kNumCellsX * kNumCellsY);
+
+  // places each label that does not collide with a placed label
+  std::vector<wxRect> rects_placed;
+  std::vector<TextLabelPosition2d> labels_placed;
+  for (auto iter = labels.cbegin(); iter != labels.cend(); iter++) {
+    const TextLabelPosition2d& label = *iter;
+    const wxRect rect(label.point.x + label.label->origin.x,
+                      label.point.y + label.label->origin.y,
+                      label.label->size_rotated.GetWidth(),
+                      label.label->size_rotated.GetHeight());
+
+    // solves for the cells that the label covers
+    const int ix0 = std::min(std::max(
+        rect.GetLeft() / kSizeCellDeclutter + 1, 0), kNumCellsX - 1);
+    const int ix1 = std::min(std::max(
+        rect.GetRight() / kSizeCellDeclutter + 1, 0), kNumCellsX - 1);
+    const int iy0 = std::min(std::max(
+        rect.GetTop() / kSizeCellDeclutter + 1, 0), kNumCellsY - 1);
+    const int iy1 = std::min(std::max(
+        rect.GetBottom() / kSizeCellDeclutter + 1, 0), kNumCellsY - 1);
+
+    // checks for collisions with placed labels in the covered cells
+    bool is_colliding = false;
+    for (int iy = iy0; (iy <= iy1) && (is_colliding == false); iy++) {
+      for (int ix = ix0; (ix <= ix1) && (is_colliding == false); ix++) {
+        const std::vector<unsigned int>& cell = cells[iy * kNumCellsX + ix];
+        for (auto iter_cell = cell.cbegin(); iter_cell != cell.cend();
+             iter_cell++) {
+          if (rects_placed[*iter_cell].Intersects(rect) == true) {
+            is_colliding = true;
+            break;
+          }
+        }
+      }
+    }
+
+    if (is_colliding == true) {
       continue;
     }
 
-    // translates point to graphics coordinates
-    wxCoord xg, yg;
-    xg = DataToGraphics(x, axis_horizontal.Min(), axis_horizontal.Max(),
-                        rc.GetWidth(), false);
-    yg = DataToGraphics(y, axis_vertical.Min(), axis_vertical.Max(),
-                        rc.GetHeight(), true);
+    // places the label
+    for (int iy = iy0; iy <= iy1; iy++) {
+      for (int ix = ix0; ix <= ix1; ix++) {
+        cells[iy * kNumCellsX + ix].push_back(rects_placed.size());
+      }
+    }
+
+    rects_placed.push_back(rect);
+    labels_placed.push_back(label);
+  }
+
+  labels.swap(labels_placed);
+}
+
+template <typename T>
+void TextRenderer2d::PositionLabels(
+    wxDC& dc, const wxColour& color, const std::vector<T>& points,
+    const std::vector<unsigned int>& indexes,
+    std::vector<TextLabelPosition2d>& labels) const {
+  // clears the label cache if the font or color has changed
+  const wxString font = dc.GetFont().GetNativeFontInfoDesc();
+  if ((font != font_cache_) || (color != color_cache_)
+      || (kNumLabelsMax < labels_.size())) {
+    labels_.clear();
+    font_cache_ = font;
+    color_cache_ = color;
+  }
+
+  // gets the typed text dataset
+  const std::vector<const Text2d*>* data = dataset()->elements();
+
+  // positions each visible text
+  labels.clear();
+  labels.reserve(points.size());
+  for (std::size_t k = 0; k < points.size(); k++) {
+    // gets text
+    const Text2d* text = (*data)[indexes[k]];
+
+    // gets graphics coordinates
+    wxCoord xg = static_cast<wxCoord>(points[k].x);
+    wxCoord yg = static_cast<wxCoord>(points[k].y);
 
     // calculates the graphics offset due to boundary position and angle
     // offset is vector from upper left position to specified boundary position
     Vector2d offset;
-    wxSize size = dc.GetTextExtent(text->message);
+    const TextLabel2d& label = Label(dc, *text, color);
+    const wxSize& size = label.size;
     if (text->position == Text2d::BoundaryPosition::kCenterLower) {
       offset.set_x(size.GetX() / 2);
       offset.set_y(-size.GetY());
@@ -101,16 +367,78 @@ void TextRenderer2d::Draw(wxDC& dc, wxRect rc, const PlotAxis& axis_horizontal,
     xg -= static_cast<int>(offset.x());
     yg += static_cast<int>(offset.y());
 
-    // draws onto DC
-    dc.DrawRotatedText(text->message, xg, yg, text->angle);
+    TextLabelPosition2d position;
+    position.label = &label;
+    position.point = wxPoint(xg, yg);
+    position.point_exact = wxRealPoint(points[k].x - offset.x(),
+                                       points[k].y + offset.y());
+    position.text = text;
+    labels.push_back(position);
   }
 }
 
-const wxColour* TextRenderer2d::color() const {
-  return color_;
-}
+void TextRenderer2d::RasterizeLabel(const wxDC& dc, const Text2d& text,
+                                    const wxColour& color,
+                                    TextLabel2d& label) {
+  const int kWidth = label.size_rotated.GetWidth();
+  const int kHeight = label.size_rotated.GetHeight();
+  if ((kWidth <= 0) || (kHeight <= 0)) {
+    return;
+  }
 
-void TextRenderer2d::set_color(const wxColour* color) {
-  color_ = color;
+  // creates a fully transparent image
+  wxImage image(kWidth, kHeight);
+  image.InitAlpha();
+  std::fill(image.GetAlpha(), image.GetAlpha() + kWidth * kHeight, 0);
+
+  // draws the rotated text into the image
+  wxGraphicsContext* context = wxGraphicsContext::Create(image);
+  if (context == nullptr) {
+    return;
+  }
+
+  context->SetFont(dc.GetFont(), color);
+  context->DrawText(text.message, -label.origin.x, -label.origin.y,
+                    wxDegToRad(text.angle));
+  delete context;
+
+  label.bitmap = wxBitmap(image);
 }
 
+template <typename T>
+void TextRenderer2d::TransformText(const wxRect& rc,
+                                   const PlotAxis& axis_horizontal,
+                                   const PlotAxis& axis_vertical,
+                                   std::vector<T>& points,
+                                   std::vector<unsigned int>& indexes) const {
+  // gets the typed text dataset
+  const TextDataSet2d* dataset = this->dataset();
+
+  // gets the visible elements from the spatial index, if available
+  const std::vector<const Text2d*>* data = dataset->elements();
+  std::vector<unsigned int> indexes_visible;
+  const bool is_indexed = dataset->IndexesVisible(axis_horizontal,
+                                                  axis_vertical,
+                                                  indexes_visible);
+  const std::size_t count = is_indexed ? indexes_visible.size() : data->size();
+
+  // gathers the text points into contiguous arrays
+  std::vector<float> x(count);
+  std::vector<float> y(count);
+  for (std::size_t k = 0; k < count; k++) {
+    const Text2d* text = (*data)[is_indexed ? indexes_visible[k] : k];
+    x[k] = text->point.x;
+    y[k] = text->point.y;
+  }
+
+  // transforms the points, culling text that is out of range
+  const GraphicsKernel2d kernel(axis_horizontal, axis_vertical, rc);
+  kernel.TransformPoints(x.data(), y.data(), nullptr, count, points, indexes);
+
+  // maps the gathered array positions back to dataset element indexes
+  if (is_indexed == true) {
+    for (auto iter = indexes.begin(); iter != indexes.end(); iter++) {
+      *iter = indexes_visible[*iter];
+    }
+  }
+}
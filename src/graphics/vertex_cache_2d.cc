@@ -0,0 +1,159 @@
+// This is free and unencumbered software released into the public domain.
+// For more information, please refer to <http://unlicense.org/>
+
+#include "appcommon/graphics/vertex_cache_2d.h"
+
+#include <cmath>
+
+namespace {
+
+/// The fraction of the view size that is added to each side of the cached
+/// region.
+const float kFractionGuardBand = 0.5;
+
+}  // namespace
+
+VertexCache2d::VertexCache2d() {
+  Clear();
+}
+
+VertexCache2d::~VertexCache2d() {
+}
+
+void VertexCache2d::Clear() {
+  indexes_.clear();
+  points_.clear();
+
+  is_valid_ = false;
+  margin_ = 0;
+  scale_x_ = 0;
+  scale_y_ = 0;
+  version_ = 0;
+  x_max_ = -999999;
+  x_min_ = 999999;
+  y_max_ = -999999;
+  y_min_ = 999999;
+}
+
+bool VertexCache2d::IsValid(const PlotAxis& axis_horizontal,
+                            const PlotAxis& axis_vertical,
+                            const wxRect& rc, const uint64_t& version) const {
+  if ((is_valid_ == false) || (version != version_)) {
+    return false;
+  }
+
+  // checks if the scale has changed
+  if ((rc.GetWidth() / axis_horizontal.range() != scale_x_)
+      || (rc.GetHeight() / axis_vertical.range() != scale_y_)) {
+    return false;
+  }
+
+  // checks if the view is within the cached region
+  return (x_min_ <= axis_horizontal.Min()) && (axis_horizontal.Max() <= x_max_)
+      && (y_min_ <= axis_vertical.Min()) && (axis_vertical.Max() <= y_max_);
+}
+
+void VertexCache2d::Points(const PlotAxis& axis_horizontal,
+                           const PlotAxis& axis_vertical,
+                           const wxRect& rc, std::vector<wxPoint>& points,
+                           std::vector<unsigned int>& indexes) const {
+  points.clear();
+  indexes.clear();
+
+  const wxPoint translation = Translation(axis_horizontal, axis_vertical);
+
+  // translates the points and culls any outside of the view
+  for (std::size_t i = 0; i < points_.size(); i++) {
+    const int x = points_[i].x + translation.x;
+    const int y = points_[i].y + translation.y;
+    if ((x < -margin_) || (rc.GetWidth() + margin_ < x)
+        || (y < -margin_) || (rc.GetHeight() + margin_ < y)) {
+      continue;
+    }
+
+    points.push_back(wxPoint(x, y));
+    indexes.push_back(indexes_[i]);
+  }
+}
+
+void VertexCache2d::Region(const PlotAxis& axis_horizontal,
+                           const PlotAxis& axis_vertical, const wxRect& rc,
+                           PlotAxis& axis_horizontal_cache,
+                           PlotAxis& axis_vertical_cache, wxRect& rc_cache) {
+  // expands the graphics rect by a whole number of pixels on each side
+  const int kGuardX = static_cast<int>(rc.GetWidth() * kFractionGuardBand);
+  const int kGuardY = static_cast<int>(rc.GetHeight() * kFractionGuardBand);
+  rc_cache = wxRect(0, 0, rc.GetWidth() + 2 * kGuardX,
+                    rc.GetHeight() + 2 * kGuardY);
+
+  // expands the axes to match, keeping the same scale
+  axis_horizontal_cache = PlotAxis(PlotAxis::OrientationType::kHorizontal);
+  axis_horizontal_cache.set_position_center(axis_horizontal.position_center());
+  axis_horizontal_cache.set_range(
+      axis_horizontal.range() * rc_cache.GetWidth() / rc.GetWidth());
+
+  axis_vertical_cache = PlotAxis(PlotAxis::OrientationType::kVertical);
+  axis_vertical_cache.set_position_center(axis_vertical.position_center());
+  axis_vertical_cache.set_range(
+      axis_vertical.range() * rc_cache.GetHeight() / rc.GetHeight());
+}
+
+void VertexCache2d::Segments(const PlotAxis& axis_horizontal,
+                             const PlotAxis& axis_vertical,
+                             const wxRect& rc,
+                             std::vector<wxPoint>& points) const {
+  points.clear();
+
+  const wxPoint translation = Translation(axis_horizontal, axis_vertical);
+
+  // translates the segments and culls any entirely outside of the view
+  for (std::size_t i = 0; i + 1 < points_.size(); i += 2) {
+    const wxPoint point_start(points_[i].x + translation.x,
+                              points_[i].y + translation.y);
+    const wxPoint point_end(points_[i + 1].x + translation.x,
+                            points_[i + 1].y + translation.y);
+
+    if (((point_start.x < 0) && (point_end.x < 0))
+        || ((rc.GetWidth() < point_start.x) && (rc.GetWidth() < point_end.x))
+        || ((point_start.y < 0) && (point_end.y < 0))
+        || ((rc.GetHeight() < point_start.y)
+            && (rc.GetHeight() < point_end.y))) {
+      continue;
+    }
+
+    points.push_back(point_start);
+    points.push_back(point_end);
+  }
+}
+
+void VertexCache2d::Update(const PlotAxis& axis_horizontal,
+                           const PlotAxis& axis_vertical, const wxRect& rc,
+                           const PlotAxis& axis_horizontal_cache,
+                           const PlotAxis& axis_vertical_cache,
+                           const uint64_t& version, const int& margin,
+                           std::vector<wxPoint>& points,
+                           std::vector<unsigned int>& indexes) {
+  points_.swap(points);
+  indexes_.swap(indexes);
+
+  margin_ = margin;
+  scale_x_ = rc.GetWidth() / axis_horizontal.range();
+  scale_y_ = rc.GetHeight() / axis_vertical.range();
+  version_ = version;
+  x_max_ = axis_horizontal_cache.Max();
+  x_min_ = axis_horizontal_cache.Min();
+  y_max_ = axis_vertical_cache.Max();
+  y_min_ = axis_vertical_cache.Min();
+  is_valid_ = true;
+}
+
+wxPoint VertexCache2d::Translation(const PlotAxis& axis_horizontal,
+                                   const PlotAxis& axis_vertical) const {
+  wxPoint translation;
+  translation.x = static_cast<int>(std::lround(
+      (x_min_ - axis_horizontal.Min()) * scale_x_));
+  translation.y = static_cast<int>(std::lround(
+      (axis_vertical.Max() - y_max_) * scale_y_));
+
+  return translation;
+}